@@ -9,38 +9,432 @@
 #ifndef YCSB_C_CLIENT_H_
 #define YCSB_C_CLIENT_H_
 
+#include <algorithm>
+#include <atomic>
+#include <barrier>
+#include <chrono>
+#include <coroutine>
+#include <exception>
+#include <functional>
 #include <iostream>
+#include <queue>
 #include <string>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
 
 #include "db.h"
 #include "core_workload.h"
+#include "generator.h"
+#include "handoff_workload.h"
+#include "measurements.h"
+#include "utils/cache_flush.h"
 #include "utils/countdown_latch.h"
 #include "utils/rate_limit.h"
+#include "utils/thread_control.h"
 #include "utils/utils.h"
 
 namespace ycsbc {
 
-inline int ClientThread(ycsbc::DB *db, ycsbc::CoreWorkload *wl, const int num_ops, bool is_loading,
-                        bool init_db, bool cleanup_db, utils::CountDownLatch *latch, utils::RateLimiter *rlim) {
+using ClientThreadFunc = int64_t (*)(DB *db, CoreWorkload *wl, int thread_id, int thread_count,
+                                     const int64_t num_ops, bool is_loading, bool init_db,
+                                     bool cleanup_db, utils::CountDownLatch *latch,
+                                     utils::RateLimiter *rlim, utils::ThreadControl *control,
+                                     ThreadState *saved_state);
+
+///
+/// A coroutine issuing transactions for a client thread. It starts suspended,
+/// and suspends again between choosing each transaction and issuing it.
+///
+class TransactionCoroutine {
+ public:
+  struct promise_type {
+    std::exception_ptr exception;
+
+    TransactionCoroutine get_return_object() {
+      return TransactionCoroutine(std::coroutine_handle<promise_type>::from_promise(*this));
+    }
+    std::suspend_always initial_suspend() noexcept { return {}; }
+    std::suspend_always final_suspend() noexcept { return {}; }
+    void return_void() {}
+    void unhandled_exception() { exception = std::current_exception(); }
+  };
+
+  explicit TransactionCoroutine(std::coroutine_handle<promise_type> handle) : handle_(handle) {}
+  TransactionCoroutine(TransactionCoroutine &&other) noexcept : handle_(other.handle_) {
+    other.handle_ = nullptr;
+  }
+  TransactionCoroutine(const TransactionCoroutine &) = delete;
+  TransactionCoroutine &operator=(const TransactionCoroutine &) = delete;
+  ~TransactionCoroutine() {
+    if (handle_) {
+      handle_.destroy();
+    }
+  }
+
+  bool Done() const { return handle_.done(); }
+
+  void Resume() {
+    handle_.resume();
+    if (handle_.promise().exception) {
+      std::rethrow_exception(handle_.promise().exception);
+    }
+  }
+
+ private:
+  std::coroutine_handle<promise_type> handle_;
+};
+
+template <typename DBType>
+TransactionCoroutine InterleavedTransactions(DBType &db, CoreWorkload *wl, ThreadState &state,
+                                             int64_t &remaining, int64_t &ops,
+                                             utils::RateLimiter *rlim,
+                                             utils::ThreadControl *control) {
+  PendingTransaction txn;
+  while (remaining > 0 && (!control || control->Continue())) {
+    remaining--;
+    if (rlim) {
+      rlim->Consume(1);
+    }
+    wl->StartTransaction(db, state, txn);
+    // let the other coroutines run while the record is prefetched
+    co_await std::suspend_always{};
+    wl->FinishTransaction(db, state, txn);
+    ops++;
+  }
+}
+
+///
+/// Runs num_ops transactions as wl->coroutines() interleaved coroutines,
+/// resumed round-robin. Returns the number of transactions issued.
+///
+template <typename DBType>
+inline int64_t RunInterleavedTransactions(DBType &db, CoreWorkload *wl, ThreadState &state,
+                                          const int64_t num_ops, utils::RateLimiter *rlim,
+                                          utils::ThreadControl *control) {
+  int64_t remaining = num_ops;
+  int64_t ops = 0;
+  std::vector<TransactionCoroutine> coroutines;
+  for (int i = 0; i < wl->coroutines(); ++i) {
+    coroutines.push_back(InterleavedTransactions(db, wl, state, remaining, ops, rlim, control));
+  }
+  bool running = true;
+  while (running) {
+    running = false;
+    for (auto &coroutine : coroutines) {
+      if (!coroutine.Done()) {
+        coroutine.Resume();
+        running = true;
+      }
+    }
+  }
+  return ops;
+}
+
+///
+/// Client loop for DBs of type DBType. Unless DBType is DB itself, the
+/// workload's insert and transaction paths are instantiated for DBType, so
+/// calls into a final DBType need no virtual dispatch. The client continues
+/// from saved_state, left by an earlier run of the same client, or starts
+/// from a new state if it is nullptr.
+///
+template <typename DBType>
+inline int64_t TypedClientThread(ycsbc::DB *db, ycsbc::CoreWorkload *wl, int thread_id,
+                                 int thread_count, const int64_t num_ops, bool is_loading,
+                                 bool init_db, bool cleanup_db, utils::CountDownLatch *latch,
+                                 utils::RateLimiter *rlim, utils::ThreadControl *control,
+                                 ThreadState *saved_state) {
 
   try {
     if (init_db) {
       db->Init();
     }
 
-    int ops = 0;
-    for (int i = 0; i < num_ops; ++i) {
+    ThreadState new_state;
+    if (!saved_state) {
+      new_state = wl->InitThread(thread_id, thread_count);
+    }
+    ThreadState &state = saved_state ? *saved_state : new_state;
+
+    int64_t ops = 0;
+    if (!is_loading && wl->coroutines() > 1) {
+      ops = RunInterleavedTransactions(static_cast<DBType &>(*db), wl, state, num_ops, rlim,
+                                       control);
+    } else if (!is_loading && wl->batch_size() > 1) {
+      while (ops < num_ops) {
+        if (control && !control->Continue()) {
+          break;
+        }
+        const int batch = std::min<int64_t>(wl->batch_size(), num_ops - ops);
+        if (rlim) {
+          rlim->Consume(batch);
+        }
+        if constexpr (std::is_same_v<DBType, DB>) {
+          wl->DoTransactionBatch(*db, state, batch);
+        } else {
+          wl->ExecuteTransactionBatch(static_cast<DBType &>(*db), state, batch);
+        }
+        ops += batch;
+      }
+    } else if (is_loading && wl->load_batch_size() > 1) {
+      while (ops < num_ops) {
+        const int batch = std::min<int64_t>(wl->load_batch_size(), num_ops - ops);
+        if (rlim) {
+          rlim->Consume(batch);
+        }
+        if constexpr (std::is_same_v<DBType, DB>) {
+          wl->DoBulkInsert(*db, state, batch);
+        } else {
+          wl->ExecuteBulkInsert(static_cast<DBType &>(*db), state, batch);
+        }
+        ops += batch;
+      }
+    } else {
+      for (int64_t i = 0; i < num_ops; ++i) {
+        if (control && !control->Continue()) {
+          break;
+        }
+        if (rlim) {
+          rlim->Consume(1);
+        }
+
+        if constexpr (std::is_same_v<DBType, DB>) {
+          if (is_loading) {
+            wl->DoInsert(*db, state);
+          } else {
+            wl->DoTransaction(*db, state);
+          }
+        } else {
+          if (is_loading) {
+            wl->ExecuteInsert(static_cast<DBType &>(*db), state);
+          } else {
+            wl->ExecuteTransaction(static_cast<DBType &>(*db), state);
+          }
+        }
+        ops++;
+      }
+    }
+
+    if (cleanup_db) {
+      db->Cleanup();
+    }
+
+    latch->CountDown();
+    return ops;
+  } catch (const utils::Exception &e) {
+    std::cerr << "Caught exception: " << e.what() << std::endl;
+    exit(1);
+  }
+}
+
+inline int64_t ClientThread(ycsbc::DB *db, ycsbc::CoreWorkload *wl, int thread_id,
+                            int thread_count, const int64_t num_ops, bool is_loading, bool init_db,
+                            bool cleanup_db, utils::CountDownLatch *latch,
+                            utils::RateLimiter *rlim, utils::ThreadControl *control,
+                            ThreadState *saved_state) {
+  return TypedClientThread<DB>(db, wl, thread_id, thread_count, num_ops, is_loading, init_db,
+                               cleanup_db, latch, rlim, control, saved_state);
+}
+
+///
+/// Multiplexes the virtual clients thread_id, thread_id + thread_count, ...
+/// below client_count onto one thread, keeping state only for those. Each client issues a transaction,
+/// thinks for a time drawn from think_time (in microseconds), and becomes
+/// ready again. The thread serves ready clients in the order they became
+/// ready. The latency a client observes, from becoming ready until its
+/// transaction completes, goes to client_measurements, so it includes time
+/// spent waiting for the thread. Transactions completed per client are
+/// added to (*client_ops)[client].
+///
+inline int64_t VirtualClientThread(ycsbc::DB *db, ycsbc::CoreWorkload *wl, int thread_id,
+                                   int thread_count, int client_count, const int64_t num_ops,
+                                   bool init_db, bool cleanup_db, Generator<uint64_t> *think_time,
+                                   utils::CountDownLatch *latch, utils::RateLimiter *rlim,
+                                   utils::ThreadControl *control,
+                                   Measurements *client_measurements,
+                                   std::vector<int64_t> *client_ops) {
+  using Clock = std::chrono::steady_clock;
+  using ReadyClient = std::pair<Clock::time_point, int>;
+
+  try {
+    if (init_db) {
+      db->Init();
+    }
+
+    // client's state is states[client / thread_count]
+    std::vector<ThreadState> states((client_count + thread_count - 1) / thread_count);
+    std::priority_queue<ReadyClient, std::vector<ReadyClient>, std::greater<ReadyClient>> ready;
+    Clock::time_point start = Clock::now();
+    for (int client = thread_id; client < client_count; client += thread_count) {
+      states[client / thread_count] = wl->InitThread(client, client_count);
+      // spread the first requests over one think time
+      ready.emplace(start + std::chrono::microseconds(think_time->Next()), client);
+    }
+
+    int64_t ops = 0;
+    PendingTransaction txn;
+    while (ops < num_ops && !ready.empty()) {
+      if (control && !control->Continue()) {
+        break;
+      }
+      auto [ready_time, client] = ready.top();
+      ready.pop();
+      // sleep through most of the wait, then spin, so timer slack does not
+      // show up as client latency
+      if (ready_time - Clock::now() > std::chrono::microseconds(200)) {
+        std::this_thread::sleep_until(ready_time - std::chrono::microseconds(200));
+      }
+      while (Clock::now() < ready_time) {
+        std::this_thread::yield();
+      }
       if (rlim) {
         rlim->Consume(1);
       }
 
-      if (is_loading) {
-        wl->DoInsert(*db);
+      ThreadState &state = states[client / thread_count];
+      wl->StartTransaction(*db, state, txn);
+      wl->FinishTransaction(*db, state, txn);
+      Clock::time_point done = Clock::now();
+      client_measurements->Report(
+          txn.op, std::chrono::duration_cast<std::chrono::nanoseconds>(done - ready_time).count());
+      (*client_ops)[client]++;
+      ops++;
+
+      ready.emplace(done + std::chrono::microseconds(think_time->Next()), client);
+    }
+
+    if (cleanup_db) {
+      db->Cleanup();
+    }
+
+    latch->CountDown();
+    return ops;
+  } catch (const utils::Exception &e) {
+    std::cerr << "Caught exception: " << e.what() << std::endl;
+    exit(1);
+  }
+}
+
+///
+/// Flushes the caches once all cold-cache client threads have reached the
+/// barrier, so no thread refills them while another thread's transactions
+/// are being measured as cold.
+///
+struct ColdCacheFlush {
+  const utils::CacheFlusher *flusher;
+  void operator()() noexcept { flusher->Flush(); }
+};
+
+///
+/// Client loop that evicts the caches before every interval transactions.
+/// The threads meet at barrier, whose completion does the one flush of the
+/// shared caches; a thread that runs out of transactions drops out. The
+/// latency of the first cold_ops transactions after each flush goes to
+/// cold_measurements, and that of the others to warm_measurements. Flushing
+/// counts towards the run time but not towards either latency.
+///
+inline int64_t ColdCacheClientThread(ycsbc::DB *db, ycsbc::CoreWorkload *wl, int thread_id,
+                                     int thread_count, const int64_t num_ops, bool init_db,
+                                     bool cleanup_db, utils::CountDownLatch *latch,
+                                     utils::RateLimiter *rlim, utils::ThreadControl *control,
+                                     std::barrier<ColdCacheFlush> *barrier, int interval,
+                                     int cold_ops, Measurements *cold_measurements,
+                                     Measurements *warm_measurements) {
+  using Clock = std::chrono::steady_clock;
+
+  try {
+    if (init_db) {
+      db->Init();
+    }
+
+    ThreadState state = wl->InitThread(thread_id, thread_count);
+
+    int64_t ops = 0;
+    PendingTransaction txn;
+    for (int64_t i = 0; i < num_ops; ++i) {
+      if (control && !control->Continue()) {
+        break;
+      }
+      if (rlim) {
+        rlim->Consume(1);
+      }
+      if (i % interval == 0) {
+        barrier->arrive_and_wait();
+      }
+
+      Clock::time_point start = Clock::now();
+      wl->StartTransaction(*db, state, txn);
+      wl->FinishTransaction(*db, state, txn);
+      uint64_t latency =
+          std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start).count();
+      if (i % interval < cold_ops) {
+        cold_measurements->Report(txn.op, latency);
+      } else {
+        warm_measurements->Report(txn.op, latency);
+      }
+      ops++;
+    }
+    barrier->arrive_and_drop();
+
+    if (cleanup_db) {
+      db->Cleanup();
+    }
+
+    latch->CountDown();
+    return ops;
+  } catch (const utils::Exception &e) {
+    std::cerr << "Caught exception: " << e.what() << std::endl;
+    exit(1);
+  }
+}
+
+///
+/// Client loop of handoff mode, as a producer or as a consumer, until wl has
+/// no items left for that role or control is stopped. Consumers report the
+/// latency of each handoff to handoff_measurements, as a HANDOFF, add the
+/// reads that missed to *misses and the items that never appeared to *lost.
+/// Returns the number of items produced or consumed.
+///
+inline int64_t HandoffClientThread(ycsbc::DB *db, ycsbc::HandoffWorkload *wl, int thread_id,
+                                   int thread_count, bool producer, bool init_db,
+                                   bool cleanup_db, utils::CountDownLatch *latch,
+                                   utils::RateLimiter *rlim, utils::ThreadControl *control,
+                                   Measurements *handoff_measurements, uint64_t *misses,
+                                   uint64_t *lost) {
+  try {
+    if (init_db) {
+      db->Init();
+    }
+
+    ThreadState state = wl->InitThread(thread_id, thread_count);
+
+    int64_t ops = 0;
+    uint64_t latency;
+    while (control->Continue()) {
+      if (rlim) {
+        rlim->Consume(1);
+      }
+      if (producer) {
+        if (!wl->Produce(*db, state)) {
+          break;
+        }
       } else {
-        wl->DoTransaction(*db);
+        HandoffWorkload::ConsumeStatus status = wl->Consume(*db, state, control, &latency, misses);
+        if (status == HandoffWorkload::kDone) {
+          break;
+        }
+        if (status == HandoffWorkload::kLost) {
+          (*lost)++;
+          continue;
+        }
+        handoff_measurements->Report(HANDOFF, latency);
       }
       ops++;
     }
+    if (producer) {
+      wl->ProducerFinished();
+    }
 
     if (cleanup_db) {
       db->Cleanup();
@@ -17,6 +17,7 @@
 #include "zipfian_generator.h"
 
 #include <algorithm>
+#include <charconv>
 #include <random>
 #include <string>
 
@@ -36,7 +37,12 @@ const char *ycsbc::kOperationString[ycsbc::MAXOPTYPE] = {
     "SCAN-FAILED",
     "READMODIFYWRITE-FAILED",
     "DELETE-FAILED",
-    "BADREAD"};
+    "BADREAD",
+    "MULTIREAD",
+    "MULTIUPDATE",
+    "MULTIREAD-FAILED",
+    "MULTIUPDATE-FAILED",
+    "HANDOFF"};
 
 const string CoreWorkload::TABLENAME_PROPERTY = "table";
 const string CoreWorkload::TABLENAME_DEFAULT = "usertable";
@@ -57,6 +63,12 @@ const string CoreWorkload::READ_ALL_FIELDS_DEFAULT = "true";
 const string CoreWorkload::WRITE_ALL_FIELDS_PROPERTY = "writeallfields";
 const string CoreWorkload::WRITE_ALL_FIELDS_DEFAULT = "false";
 
+const std::string CoreWorkload::READMODIFYWRITE_METHOD_PROPERTY = "readmodifywrite.method";
+const std::string CoreWorkload::READMODIFYWRITE_METHOD_DEFAULT = "separate";
+
+const std::string CoreWorkload::INSERT_IF_ABSENT_PROPERTY = "insertifabsent";
+const std::string CoreWorkload::INSERT_IF_ABSENT_DEFAULT = "false";
+
 const string CoreWorkload::READ_PROPORTION_PROPERTY = "readproportion";
 const string CoreWorkload::READ_PROPORTION_DEFAULT = "0.95";
 
@@ -76,6 +88,12 @@ const string CoreWorkload::READMODIFYWRITE_PROPORTION_PROPERTY =
     "readmodifywriteproportion";
 const string CoreWorkload::READMODIFYWRITE_PROPORTION_DEFAULT = "0.0";
 
+const string CoreWorkload::DELETE_PROPORTION_PROPERTY = "deleteproportion";
+const string CoreWorkload::DELETE_PROPORTION_DEFAULT = "0.0";
+
+const string CoreWorkload::CHURN_PROPERTY = "churn";
+const string CoreWorkload::CHURN_DEFAULT = "false";
+
 const string CoreWorkload::REQUEST_DISTRIBUTION_PROPERTY =
     "requestdistribution";
 const string CoreWorkload::REQUEST_DISTRIBUTION_DEFAULT = "uniform";
@@ -107,9 +125,68 @@ const std::string CoreWorkload::FIELD_NAME_PREFIX_DEFAULT = "field";
 
 const std::string CoreWorkload::ZIPFIAN_CONST_PROPERTY = "zipfian_const";
 
+const std::string CoreWorkload::READ_KEY_PREFIX = "read.";
+const std::string CoreWorkload::UPDATE_KEY_PREFIX = "update.";
+const std::string CoreWorkload::SCAN_KEY_PREFIX = "scan.";
+const std::string CoreWorkload::READMODIFYWRITE_KEY_PREFIX = "readmodifywrite.";
+
+const std::string CoreWorkload::HOTSET_FRACTION_PROPERTY = "hotset.fraction";
+const std::string CoreWorkload::HOTSET_FRACTION_DEFAULT = "0";
+
+const std::string CoreWorkload::HOTSET_OPN_FRACTION_PROPERTY = "hotset.opnfraction";
+const std::string CoreWorkload::HOTSET_OPN_FRACTION_DEFAULT = "0.8";
+
+const std::string CoreWorkload::HOTSET_OVERLAP_PROPERTY = "hotset.overlap";
+const std::string CoreWorkload::HOTSET_OVERLAP_DEFAULT = "0";
+
+const std::string CoreWorkload::HOTKEY_COUNT_PROPERTY = "hotkey.count";
+const std::string CoreWorkload::HOTKEY_COUNT_DEFAULT = "0";
+
+const std::string CoreWorkload::HOTKEY_FRACTION_PROPERTY = "hotkey.fraction";
+const std::string CoreWorkload::HOTKEY_FRACTION_DEFAULT = "1";
+
+const std::string CoreWorkload::KEY_PARTITIONING_PROPERTY = "keypartitioning";
+const std::string CoreWorkload::KEY_PARTITIONING_DEFAULT = "shared";
+
+const std::string CoreWorkload::CROSS_PARTITION_READ_FRACTION_PROPERTY =
+    "keypartitioning.crossreadfraction";
+const std::string CoreWorkload::CROSS_PARTITION_READ_FRACTION_DEFAULT = "0";
+
+const std::string CoreWorkload::COROUTINES_PROPERTY = "coroutines";
+const std::string CoreWorkload::COROUTINES_DEFAULT = "1";
+
+const std::string CoreWorkload::LOAD_BATCH_SIZE_PROPERTY = "loadbatchsize";
+const std::string CoreWorkload::LOAD_BATCH_SIZE_DEFAULT = "1";
+
+const std::string CoreWorkload::BATCH_SIZE_PROPERTY = "batchsize";
+const std::string CoreWorkload::BATCH_SIZE_DEFAULT = "1";
+
+const std::string CoreWorkload::DATASET_FILE_PROPERTY = "dataset.file";
+
+const std::string CoreWorkload::TRACE_RECORD_PROPERTY = "trace.record";
+
 namespace ycsbc {
 
 void CoreWorkload::Init(const utils::Properties &p) {
+  // the settings running clients lay out their keys and thread states for,
+  // which InitSharingKeySpace carries over to every group and phase
+  const std::pair<const std::string &, const std::string &> layout_properties[] = {
+      {FIELD_COUNT_PROPERTY, FIELD_COUNT_DEFAULT},
+      {FIELD_NAME_PREFIX, FIELD_NAME_PREFIX_DEFAULT},
+      {ZERO_PADDING_PROPERTY, ZERO_PADDING_DEFAULT},
+      {INSERT_ORDER_PROPERTY, INSERT_ORDER_DEFAULT},
+      {INSERT_START_PROPERTY, INSERT_START_DEFAULT},
+      {HOTSET_FRACTION_PROPERTY, HOTSET_FRACTION_DEFAULT},
+      {HOTSET_OVERLAP_PROPERTY, HOTSET_OVERLAP_DEFAULT},
+      {KEY_PARTITIONING_PROPERTY, KEY_PARTITIONING_DEFAULT}};
+  layout_props_.clear();
+  for (const auto &prop : layout_properties) {
+    layout_props_[prop.first] = p.GetProperty(prop.first, prop.second);
+  }
+  if (p.ContainsKey(RECORD_COUNT_PROPERTY)) {
+    layout_props_[RECORD_COUNT_PROPERTY] = p.GetProperty(RECORD_COUNT_PROPERTY);
+  }
+
   table_name_ = p.GetProperty(TABLENAME_PROPERTY, TABLENAME_DEFAULT);
 
   field_count_ =
@@ -132,7 +209,13 @@ void CoreWorkload::Init(const utils::Properties &p) {
   double readmodifywrite_proportion = std::stod(p.GetProperty(
       READMODIFYWRITE_PROPORTION_PROPERTY, READMODIFYWRITE_PROPORTION_DEFAULT));
 
-  record_count_ = std::stoi(p.GetProperty(RECORD_COUNT_PROPERTY));
+  churn_ = utils::StrToBool(p.GetProperty(CHURN_PROPERTY, CHURN_DEFAULT));
+  // churn deletes as fast as it inserts, keeping the number of live records
+  double delete_proportion = std::stod(p.GetProperty(
+      DELETE_PROPORTION_PROPERTY,
+      churn_ ? std::to_string(insert_proportion) : DELETE_PROPORTION_DEFAULT));
+
+  record_count_ = std::stoull(p.GetProperty(RECORD_COUNT_PROPERTY));
   std::string request_dist = p.GetProperty(REQUEST_DISTRIBUTION_PROPERTY,
                                            REQUEST_DISTRIBUTION_DEFAULT);
   int min_scan_len = std::stoi(
@@ -141,8 +224,8 @@ void CoreWorkload::Init(const utils::Properties &p) {
       p.GetProperty(MAX_SCAN_LENGTH_PROPERTY, MAX_SCAN_LENGTH_DEFAULT));
   std::string scan_len_dist = p.GetProperty(SCAN_LENGTH_DISTRIBUTION_PROPERTY,
                                             SCAN_LENGTH_DISTRIBUTION_DEFAULT);
-  int insert_start =
-      std::stoi(p.GetProperty(INSERT_START_PROPERTY, INSERT_START_DEFAULT));
+  insert_start_ =
+      std::stoull(p.GetProperty(INSERT_START_PROPERTY, INSERT_START_DEFAULT));
 
   zero_padding_ =
       std::stoi(p.GetProperty(ZERO_PADDING_PROPERTY, ZERO_PADDING_DEFAULT));
@@ -151,6 +234,19 @@ void CoreWorkload::Init(const utils::Properties &p) {
       p.GetProperty(READ_ALL_FIELDS_PROPERTY, READ_ALL_FIELDS_DEFAULT));
   write_all_fields_ = utils::StrToBool(
       p.GetProperty(WRITE_ALL_FIELDS_PROPERTY, WRITE_ALL_FIELDS_DEFAULT));
+  std::string rmw_method = p.GetProperty(READMODIFYWRITE_METHOD_PROPERTY,
+                                         READMODIFYWRITE_METHOD_DEFAULT);
+  if (rmw_method == "separate") {
+    rmw_method_ = kRmwSeparate;
+  } else if (rmw_method == "compound") {
+    rmw_method_ = kRmwCompound;
+  } else if (rmw_method == "cas") {
+    rmw_method_ = kRmwCas;
+  } else {
+    throw utils::Exception("Unknown read-modify-write method: " + rmw_method);
+  }
+  insert_if_absent_ = utils::StrToBool(
+      p.GetProperty(INSERT_IF_ABSENT_PROPERTY, INSERT_IF_ABSENT_DEFAULT));
 
   if (p.GetProperty(INSERT_ORDER_PROPERTY, INSERT_ORDER_DEFAULT) == "hashed") {
     ordered_inserts_ = false;
@@ -158,6 +254,27 @@ void CoreWorkload::Init(const utils::Properties &p) {
     ordered_inserts_ = true;
   }
 
+  if (!dataset_ && p.ContainsKey(DATASET_FILE_PROPERTY)) {
+    dataset_ = std::make_shared<Dataset>(p.GetProperty(DATASET_FILE_PROPERTY));
+  }
+  if (dataset_) {
+    if (dataset_->record_count() < insert_start_ + record_count_) {
+      throw utils::Exception("Dataset holds " + std::to_string(dataset_->record_count()) +
+                             " records, fewer than insertstart + recordcount");
+    }
+    // the record layout and key format are those the dataset was written with
+    field_count_ = dataset_->field_count();
+    zero_padding_ = dataset_->zero_padding();
+    ordered_inserts_ = dataset_->ordered_inserts();
+    replay_ops_ = dataset_->op_count() > 0;
+  }
+
+  if (!recorder_ && p.ContainsKey(TRACE_RECORD_PROPERTY)) {
+    recorder_ = std::make_shared<TraceRecorder>(
+        p.GetProperty(TRACE_RECORD_PROPERTY),
+        std::stoull(p.GetProperty(OPERATION_COUNT_PROPERTY, "0")));
+  }
+
   if (read_proportion > 0) {
     op_chooser_.AddValue(READ, read_proportion);
   }
@@ -179,12 +296,195 @@ void CoreWorkload::Init(const utils::Properties &p) {
     op_chooser_.AddValue(READMODIFYWRITE, readmodifywrite_proportion);
   }
 
-  insert_key_sequence_ = new CounterGenerator(insert_start);
-  transaction_insert_key_sequence_ =
-      new AcknowledgedCounterGenerator(record_count_);
+  if (delete_proportion > 0) {
+    op_chooser_.AddValue(DELETE, delete_proportion);
+  }
+
+  if (!shares_key_sequences_) {
+    transaction_insert_key_sequence_ =
+        new AcknowledgedCounterGenerator(record_count_);
+    delete_key_sequence_ = new CounterGenerator(0);
+  }
+
+  key_chooser_ = CreateKeyChooser(p, request_dist, ZIPFIAN_CONST_PROPERTY, insert_proportion);
+
+  const std::pair<Operation, const std::string &> op_key_prefixes[] = {
+      {READ, READ_KEY_PREFIX},
+      {UPDATE, UPDATE_KEY_PREFIX},
+      {SCAN, SCAN_KEY_PREFIX},
+      {READMODIFYWRITE, READMODIFYWRITE_KEY_PREFIX}};
+  std::fill(std::begin(op_key_chooser_), std::end(op_key_chooser_), key_chooser_);
+  for (const auto &op_prefix : op_key_prefixes) {
+    const std::string dist_property = op_prefix.second + REQUEST_DISTRIBUTION_PROPERTY;
+    const std::string zipfian_property = op_prefix.second + ZIPFIAN_CONST_PROPERTY;
+    if (!p.ContainsKey(dist_property) && !p.ContainsKey(zipfian_property)) {
+      continue;
+    }
+    op_key_chooser_[op_prefix.first] = CreateKeyChooser(
+        p, p.GetProperty(dist_property, request_dist),
+        p.ContainsKey(zipfian_property) ? zipfian_property : ZIPFIAN_CONST_PROPERTY,
+        insert_proportion);
+  }
+
+  double hotset_fraction = std::stod(
+      p.GetProperty(HOTSET_FRACTION_PROPERTY, HOTSET_FRACTION_DEFAULT));
+  if (hotset_fraction > 0) {
+    double hotset_overlap = std::stod(
+        p.GetProperty(HOTSET_OVERLAP_PROPERTY, HOTSET_OVERLAP_DEFAULT));
+    if (hotset_fraction > 1 || hotset_overlap < 0 || hotset_overlap > 1) {
+      throw utils::Exception("Invalid hot set fraction or overlap");
+    }
+    hotset_size_ = std::max<uint64_t>(1, hotset_fraction * record_count_);
+    hotset_shared_ = hotset_overlap * hotset_size_;
+    hotset_opn_fraction_ = std::stod(
+        p.GetProperty(HOTSET_OPN_FRACTION_PROPERTY, HOTSET_OPN_FRACTION_DEFAULT));
+    if (hotset_opn_fraction_ < 0 || hotset_opn_fraction_ > 1) {
+      throw utils::Exception("Invalid hot set operation fraction");
+    }
+  }
+
+  std::string key_partitioning = p.GetProperty(KEY_PARTITIONING_PROPERTY,
+                                               KEY_PARTITIONING_DEFAULT);
+  if (key_partitioning == "disjoint") {
+    disjoint_partitions_ = true;
+    cross_partition_read_fraction_ = std::stod(p.GetProperty(
+        CROSS_PARTITION_READ_FRACTION_PROPERTY, CROSS_PARTITION_READ_FRACTION_DEFAULT));
+  } else if (key_partitioning != "shared") {
+    throw utils::Exception("Unknown key partitioning: " + key_partitioning);
+  }
+  if (churn_ && disjoint_partitions_) {
+    throw utils::Exception("churn cannot be used with disjoint key partitioning");
+  }
+
+  hotkey_count_ = std::stoull(p.GetProperty(HOTKEY_COUNT_PROPERTY, HOTKEY_COUNT_DEFAULT));
+  if (hotkey_count_ > 0) {
+    hotkey_fraction_ = std::stod(p.GetProperty(HOTKEY_FRACTION_PROPERTY,
+                                               HOTKEY_FRACTION_DEFAULT));
+    if (hotkey_count_ > record_count_ || hotkey_fraction_ < 0 || hotkey_fraction_ > 1) {
+      throw utils::Exception("Invalid hot key count or fraction");
+    }
+    if (disjoint_partitions_) {
+      throw utils::Exception("hotkey.count cannot be used with disjoint key partitioning");
+    }
+  }
+
+  coroutines_ = std::stoi(p.GetProperty(COROUTINES_PROPERTY, COROUTINES_DEFAULT));
+  if (coroutines_ < 1) {
+    throw utils::Exception("coroutines must be at least 1");
+  }
+  load_batch_size_ = std::stoi(p.GetProperty(LOAD_BATCH_SIZE_PROPERTY, LOAD_BATCH_SIZE_DEFAULT));
+  if (load_batch_size_ < 1) {
+    throw utils::Exception("loadbatchsize must be at least 1");
+  }
+  batch_size_ = std::stoi(p.GetProperty(BATCH_SIZE_PROPERTY, BATCH_SIZE_DEFAULT));
+  if (batch_size_ < 1) {
+    throw utils::Exception("batchsize must be at least 1");
+  }
+  if (batch_size_ > 1 && coroutines_ > 1) {
+    throw utils::Exception("batchsize cannot be used with coroutines");
+  }
+
+  field_chooser_ = new UniformGenerator(0, field_count_ - 1);
 
+  if (scan_len_dist == "uniform") {
+    scan_len_chooser_ = new UniformGenerator(min_scan_len, max_scan_len);
+  } else if (scan_len_dist == "zipfian") {
+    scan_len_chooser_ = new ZipfianGenerator(min_scan_len, max_scan_len);
+  } else {
+    throw utils::Exception("Distribution not allowed for scan length: " +
+                           scan_len_dist);
+  }
+}
+
+void CoreWorkload::InitSharingKeySpace(const utils::Properties &p, CoreWorkload &key_space) {
+  transaction_insert_key_sequence_ = key_space.transaction_insert_key_sequence_;
+  delete_key_sequence_ = key_space.delete_key_sequence_;
+  dataset_ = key_space.dataset_;
+  recorder_ = key_space.recorder_;
+  shares_key_sequences_ = true;
+  utils::Properties shared_props = p;
+  for (const auto &prop : key_space.layout_props_) {
+    shared_props.SetProperty(prop.first, prop.second);
+  }
+  Init(shared_props);
+}
+
+void CoreWorkload::Reconfigure(const utils::Properties &p) {
+  CoreWorkload *phase = new CoreWorkload;
+  phase->InitSharingKeySpace(p, *this);
+  phases_.push_back(phase);
+  phase_.store(phase, std::memory_order_release);
+}
+
+uint64_t CoreWorkload::LoadCount(int thread_id, int thread_count) const {
+  if (disjoint_partitions_) {
+    // the keys of the range this client owns, whatever insertstart % thread_count is
+    const uint64_t first = insert_start_ +
+        (thread_id + thread_count - insert_start_ % thread_count) % thread_count;
+    const uint64_t end = insert_start_ + record_count_;
+    return first < end ? (end - 1 - first) / thread_count + 1 : 0;
+  }
+  return record_count_ / thread_count +
+         (static_cast<uint64_t>(thread_id) < record_count_ % thread_count ? 1 : 0);
+}
+
+ycsbc::ThreadState CoreWorkload::InitThread(int thread_id, int thread_count) {
+  ThreadState state;
+  state.thread_id = thread_id;
+  state.thread_count = thread_count;
+  // private parts of the hot sets are laid out back to back after the shared part
+  const int hotset_owners = hotset_threads_ > 0 ? hotset_threads_ : thread_count;
+  if (hotset_size_ > 0 &&
+      hotset_shared_ + hotset_owners * (hotset_size_ - hotset_shared_) > record_count_) {
+    throw utils::Exception("Private hot sets of " + std::to_string(hotset_owners) +
+                           " threads do not fit in recordcount");
+  }
+  state.hotset_start = hotset_shared_ +
+                       (thread_id % hotset_owners) * (hotset_size_ - hotset_shared_);
+
+  // first keys at or after the load and insert starting points owned by this client
+  auto first_owned = [&](uint64_t from) {
+    return from + (thread_id + thread_count - from % thread_count) % thread_count;
+  };
+  if (disjoint_partitions_ && record_count_ < static_cast<uint64_t>(thread_count)) {
+    throw utils::Exception("Disjoint key partitioning needs at least one record per thread");
+  }
+  if (disjoint_partitions_) {
+    state.load_next = first_owned(insert_start_);
+    state.load_stride = thread_count;
+  } else {
+    // a contiguous range per client, split the way the driver splits
+    // recordcount, so loading clients share no key counter
+    uint64_t per_client = record_count_ / thread_count;
+    uint64_t extra = record_count_ % thread_count;
+    state.load_next = insert_start_ + thread_id * per_client +
+                      std::min<uint64_t>(thread_id, extra);
+    state.load_stride = 1;
+  }
+  state.insert_next = first_owned(record_count_);
+  state.insert_limit = state.insert_next - thread_count;
+
+  state.op_begin = state.op_end = state.op_next = state.op_lap = 0;
+  if (dataset_ && dataset_->op_count() > 0) {
+    uint64_t op_count = dataset_->op_count();
+    if (op_count < static_cast<uint64_t>(thread_count)) {
+      throw utils::Exception("Dataset needs at least one operation per thread");
+    }
+    uint64_t per_client = op_count / thread_count;
+    uint64_t extra = op_count % thread_count;
+    state.op_begin = thread_id * per_client + std::min<uint64_t>(thread_id, extra);
+    state.op_end = state.op_begin + per_client + (static_cast<uint64_t>(thread_id) < extra);
+    state.op_next = state.op_begin;
+  }
+  return state;
+}
+
+ycsbc::Generator<uint64_t> *
+CoreWorkload::CreateKeyChooser(const utils::Properties &p, const std::string &request_dist,
+                               const std::string &zipfian_const_property,
+                               double insert_proportion) {
   if (request_dist == "uniform") {
-    key_chooser_ = new UniformGenerator(0, record_count_ - 1);
+    return new UniformGenerator(0, record_count_ - 1);
 
   } else if (request_dist == "zipfian") {
     // If the number of keys changes, we don't want to change popular keys.
@@ -192,31 +492,20 @@ void CoreWorkload::Init(const utils::Properties &p) {
     // that is larger than what exists at the beginning of the test.
     // If the generator picks a key that is not inserted yet, we just ignore it
     // and pick another key.
-    int op_count = std::stoi(p.GetProperty(OPERATION_COUNT_PROPERTY));
-    int new_keys = (int)(op_count * insert_proportion * 2); // a fudge factor
-    if (p.ContainsKey(ZIPFIAN_CONST_PROPERTY)) {
-      double zipfian_const = std::stod(p.GetProperty(ZIPFIAN_CONST_PROPERTY));
-      key_chooser_ = new ScrambledZipfianGenerator(
+    uint64_t op_count = std::stoull(p.GetProperty(OPERATION_COUNT_PROPERTY));
+    uint64_t new_keys = op_count * insert_proportion * 2; // a fudge factor
+    if (p.ContainsKey(zipfian_const_property)) {
+      double zipfian_const = std::stod(p.GetProperty(zipfian_const_property));
+      return new ScrambledZipfianGenerator(
           0, record_count_ + new_keys - 1, zipfian_const);
     } else {
-      key_chooser_ = new ScrambledZipfianGenerator(record_count_ + new_keys);
+      return new ScrambledZipfianGenerator(record_count_ + new_keys);
     }
   } else if (request_dist == "latest") {
-    key_chooser_ = new SkewedLatestGenerator(*transaction_insert_key_sequence_);
+    return new SkewedLatestGenerator(*transaction_insert_key_sequence_);
   } else {
     throw utils::Exception("Unknown request distribution: " + request_dist);
   }
-
-  field_chooser_ = new UniformGenerator(0, field_count_ - 1);
-
-  if (scan_len_dist == "uniform") {
-    scan_len_chooser_ = new UniformGenerator(min_scan_len, max_scan_len);
-  } else if (scan_len_dist == "zipfian") {
-    scan_len_chooser_ = new ZipfianGenerator(min_scan_len, max_scan_len);
-  } else {
-    throw utils::Exception("Distribution not allowed for scan length: " +
-                           scan_len_dist);
-  }
 }
 
 ycsbc::Generator<uint64_t> *
@@ -237,165 +526,190 @@ CoreWorkload::GetFieldLenGenerator(const utils::Properties &p) {
   }
 }
 
-std::string CoreWorkload::BuildKeyName(uint64_t key_num) {
+void CoreWorkload::BuildKeyName(uint64_t key_num, std::string &key) {
   if (!ordered_inserts_) {
     key_num = utils::Hash(key_num);
   }
-  std::string prekey = "user";
-  std::string value = std::to_string(key_num);
-  int fill = std::max(0, zero_padding_ - static_cast<int>(value.size()));
-  return prekey.append(fill, '0').append(value);
+  char digits[20];
+  char *end = std::to_chars(digits, digits + sizeof(digits), key_num).ptr;
+  int fill = std::max(0, zero_padding_ - static_cast<int>(end - digits));
+  key.assign("user").append(fill, '0').append(digits, end);
 }
 
-void CoreWorkload::BuildValues(std::vector<ycsbc::DB::Field> &values) {
+void CoreWorkload::BuildValues(std::vector<ycsbc::DB::Field> &values, uint64_t value_size) {
+  // a full record built earlier keeps its field names and storage; anything
+  // else, such as a single field, is rebuilt
+  if (values.size() != static_cast<size_t>(field_count_)) {
+    values.clear();
+  }
+  values.resize(field_count_);
   for (int i = 0; i < field_count_; ++i) {
-    values.push_back(DB::Field());
-    ycsbc::DB::Field &field = values.back();
-    field.name.append(field_prefix_).append(std::to_string(i));
-    uint64_t len = field_len_generator_->Next();
-    field.value.reserve(len);
+    ycsbc::DB::Field &field = values[i];
+    if (field.name.empty()) {
+      field.name.append(field_prefix_).append(std::to_string(i));
+    }
+    uint64_t len = value_size > 0 ? value_size : field_len_generator_->Next();
+    field.value.resize(len);
     RandomByteGenerator byte_generator;
-    std::generate_n(std::back_inserter(field.value), len,
-                    [&]() { return byte_generator.Next(); });
+    std::generate_n(field.value.begin(), len, [&]() { return byte_generator.Next(); });
   }
 }
 
-void CoreWorkload::BuildSingleValue(std::vector<ycsbc::DB::Field> &values) {
-  values.push_back(DB::Field());
-  ycsbc::DB::Field &field = values.back();
-  field.name.append(NextFieldName());
-  uint64_t len = field_len_generator_->Next();
-  field.value.reserve(len);
+void CoreWorkload::BuildSingleValue(std::vector<ycsbc::DB::Field> &values,
+                                    uint64_t value_size) {
+  // overwrites the first field in place, so its value keeps its storage
+  values.resize(1);
+  ycsbc::DB::Field &field = values[0];
+  field.name.assign(NextFieldName());
+  uint64_t len = value_size > 0 ? value_size : field_len_generator_->Next();
+  field.value.resize(len);
   RandomByteGenerator byte_generator;
-  std::generate_n(std::back_inserter(field.value), len,
-                  [&]() { return byte_generator.Next(); });
+  std::generate_n(field.value.begin(), len, [&]() { return byte_generator.Next(); });
 }
 
-uint64_t CoreWorkload::NextTransactionKeyNum() {
+uint64_t CoreWorkload::NextTransactionKeyNum(Operation op, ThreadState &state) {
+  const bool own_partition = disjoint_partitions_ &&
+      !(op == READ && utils::ThreadLocalRandomDouble() < cross_partition_read_fraction_);
+  Generator<uint64_t> *chooser = op_key_chooser_[op];
   uint64_t key_num;
+  uint64_t limit;
   do {
-    key_num = key_chooser_->Next();
-  } while (key_num > transaction_insert_key_sequence_->Last());
+    if (hotkey_count_ > 0 && (op == UPDATE || op == READMODIFYWRITE) &&
+        utils::ThreadLocalRandomDouble() < hotkey_fraction_) {
+      key_num = utils::ThreadLocalRandomDouble() * hotkey_count_;
+    } else if (hotset_size_ > 0 && utils::ThreadLocalRandomDouble() < hotset_opn_fraction_) {
+      uint64_t offset = utils::ThreadLocalRandomDouble() * hotset_size_;
+      if (offset < hotset_shared_) {
+        key_num = offset;
+      } else {
+        key_num = (state.hotset_start + offset - hotset_shared_) % record_count_;
+      }
+    } else {
+      key_num = chooser->Next();
+    }
+    if (churn_) {
+      // keys chosen as if the live records were the first ones
+      key_num += delete_key_sequence_->Last() + 1;
+    }
+    if (own_partition) {
+      // move the key into this client's residue class, keeping its rank
+      key_num = key_num - key_num % state.thread_count + state.thread_id;
+      limit = state.insert_limit;
+    } else {
+      limit = transaction_insert_key_sequence_->Last();
+    }
+  } while (key_num > limit);
   return key_num;
 }
 
-std::string CoreWorkload::NextFieldName() {
-  return std::string(field_prefix_)
-      .append(std::to_string(field_chooser_->Next()));
-}
-
-bool CoreWorkload::DoInsert(DB &db) {
-  const std::string key = BuildKeyName(insert_key_sequence_->Next());
-  std::vector<DB::Field> fields;
-  BuildValues(fields);
-  return db.Insert(table_name_, key, fields) == DB::kOK;
-}
+void CoreWorkload::ChooseTransaction(ThreadState &state, PendingTransaction &txn) {
+  CoreWorkload *phase = phase_.load(std::memory_order_acquire);
+  if (phase != nullptr) {
+    phase->ChooseTransaction(state, txn);
+    return;
+  }
 
-bool CoreWorkload::DoTransaction(DB &db) {
-  DB::Status status;
-  switch (op_chooser_.Next()) {
+  txn.workload = this;
+  if (replay_ops_) {
+    // this client's share of the dataset's operations, from the start again once used up
+    if (state.op_next == state.op_end) {
+      state.op_next = state.op_begin;
+    }
+    const DatasetOp &op = dataset_->GetOp(state.op_next++);
+    txn.op = static_cast<Operation>(op.op);
+    txn.key_num = op.key_num;
+    txn.value_size = 0;
+    BuildKeyName(txn.key_num, txn.key);
+    return;
+  }
+  txn.op = op_chooser_.Next();
+  switch (txn.op) {
   case READ:
-    status = TransactionRead(db);
-    break;
   case UPDATE:
-    status = TransactionUpdate(db);
+  case SCAN:
+  case READMODIFYWRITE:
+    txn.key_num = NextTransactionKeyNum(txn.op, state);
     break;
-  case INSERT:
-    status = TransactionInsert(db);
+  case DELETE:
+    if (churn_) {
+      txn.key_num = delete_key_sequence_->Next();
+    } else {
+      txn.key_num = NextTransactionKeyNum(txn.op, state);
+    }
     break;
-  case SCAN:
-    status = TransactionScan(db);
+  case INSERT:
+    if (disjoint_partitions_) {
+      txn.key_num = state.insert_next;
+      state.insert_next += state.thread_count;
+    } else {
+      txn.key_num = transaction_insert_key_sequence_->Next();
+    }
     break;
   case BADREAD:
-    status = TransactionBadRead(db);
-    break;
-  case READMODIFYWRITE:
-    status = TransactionReadModifyWrite(db);
+    // Generate a guaranteed-invalid key
+    txn.key_num = transaction_insert_key_sequence_->Last() + 1000000000ULL;
     break;
   default:
     throw utils::Exception("Operation request is not recognized!");
   }
-  return (status == DB::kOK);
-}
+  BuildKeyName(txn.key_num, txn.key);
 
-DB::Status CoreWorkload::TransactionRead(DB &db) {
-  uint64_t key_num = NextTransactionKeyNum();
-  const std::string key = BuildKeyName(key_num);
-  std::vector<DB::Field> result;
-  if (!read_all_fields()) {
-    std::vector<std::string> fields;
-    fields.push_back(NextFieldName());
-    return db.Read(table_name_, key, &fields, result);
-  } else {
-    return db.Read(table_name_, key, NULL, result);
+  txn.value_size = 0;
+  if (recorder_) {
+    // fix the size of written values now, so the trace holds what is written
+    if (txn.op == UPDATE || txn.op == INSERT || txn.op == READMODIFYWRITE) {
+      txn.value_size = field_len_generator_->Next();
+    }
+    recorder_->Record(txn.op, txn.key_num, txn.value_size);
   }
 }
 
-DB::Status CoreWorkload::TransactionReadModifyWrite(DB &db) {
-  uint64_t key_num = NextTransactionKeyNum();
-  const std::string key = BuildKeyName(key_num);
-  std::vector<DB::Field> result;
-
-  if (!read_all_fields()) {
-    std::vector<std::string> fields;
-    fields.push_back(NextFieldName());
-    db.Read(table_name_, key, &fields, result);
-  } else {
-    db.Read(table_name_, key, NULL, result);
+void CoreWorkload::WriteDataset(const std::string &path, uint64_t op_count) {
+  std::vector<std::string> field_names;
+  for (int i = 0; i < field_count_; i++) {
+    field_names.push_back(field_prefix_ + std::to_string(i));
   }
+  DatasetWriter writer(path, field_names, zero_padding_, ordered_inserts_);
 
+  std::string key;
   std::vector<DB::Field> values;
-  if (write_all_fields()) {
+  for (uint64_t key_num = 0; key_num < record_count_; key_num++) {
+    BuildKeyName(key_num, key);
     BuildValues(values);
-  } else {
-    BuildSingleValue(values);
+    writer.AddRecord(key, values);
   }
-  return db.Update(table_name_, key, values);
-}
 
-DB::Status CoreWorkload::TransactionScan(DB &db) {
-  uint64_t key_num = NextTransactionKeyNum();
-  const std::string key = BuildKeyName(key_num);
-  int len = scan_len_chooser_->Next();
-  std::vector<std::vector<DB::Field>> result;
-  if (!read_all_fields()) {
-    std::vector<std::string> fields;
-    fields.push_back(NextFieldName());
-    return db.Scan(table_name_, key, len, &fields, result);
-  } else {
-    return db.Scan(table_name_, key, len, NULL, result);
+  ThreadState state = InitThread(0, 1);
+  PendingTransaction txn;
+  for (uint64_t i = 0; i < op_count; i++) {
+    ChooseTransaction(state, txn);
+    writer.AddOp(txn.op, txn.key_num);
+    if (txn.op == INSERT) {
+      AcknowledgeInsert(state, txn.key_num);
+    }
   }
+  writer.Finish();
 }
 
-DB::Status CoreWorkload::TransactionBadRead(DB &db) {
-  // Generate a guaranteed-invalid key
-  uint64_t key_num = transaction_insert_key_sequence_->Last() + 1000000000ULL;
-  const std::string key = BuildKeyName(key_num);
+std::string CoreWorkload::NextFieldName() {
+  return std::string(field_prefix_)
+      .append(std::to_string(field_chooser_->Next()));
+}
 
-  std::vector<DB::Field> result;
-  return db.Read(table_name_, key, NULL, result);
+bool CoreWorkload::DoInsert(DB &db, ThreadState &state) {
+  return ExecuteInsert(db, state);
 }
 
-DB::Status CoreWorkload::TransactionUpdate(DB &db) {
-  uint64_t key_num = NextTransactionKeyNum();
-  const std::string key = BuildKeyName(key_num);
-  std::vector<DB::Field> values;
-  if (write_all_fields()) {
-    BuildValues(values);
-  } else {
-    BuildSingleValue(values);
-  }
-  return db.Update(table_name_, key, values);
+bool CoreWorkload::DoBulkInsert(DB &db, ThreadState &state, int count) {
+  return ExecuteBulkInsert(db, state, count);
 }
 
-DB::Status CoreWorkload::TransactionInsert(DB &db) {
-  uint64_t key_num = transaction_insert_key_sequence_->Next();
-  const std::string key = BuildKeyName(key_num);
-  std::vector<DB::Field> values;
-  BuildValues(values);
-  DB::Status s = db.Insert(table_name_, key, values);
-  transaction_insert_key_sequence_->Acknowledge(key_num);
-  return s;
+bool CoreWorkload::DoTransaction(DB &db, ThreadState &state) {
+  return ExecuteTransaction(db, state);
+}
+
+bool CoreWorkload::DoTransactionBatch(DB &db, ThreadState &state, int count) {
+  return ExecuteTransactionBatch(db, state, count);
 }
 
 } // namespace ycsbc
@@ -10,6 +10,11 @@
 #ifndef YCSB_C_CORE_WORKLOAD_H_
 #define YCSB_C_CORE_WORKLOAD_H_
 
+#include <algorithm>
+#include <atomic>
+#include <map>
+#include <memory>
+#include <span>
 #include <vector>
 #include <string>
 #include "db.h"
@@ -17,6 +22,8 @@
 #include "discrete_generator.h"
 #include "counter_generator.h"
 #include "acknowledged_counter_generator.h"
+#include "dataset.h"
+#include "trace.h"
 #include "utils/properties.h"
 #include "utils/utils.h"
 
@@ -36,11 +43,65 @@ enum Operation {
   READMODIFYWRITE_FAILED,
   DELETE_FAILED,
   BADREAD,
+  // values up to here are stored in trace and dataset files; add new ones below
+  MULTIREAD,
+  MULTIUPDATE,
+  MULTIREAD_FAILED,
+  MULTIUPDATE_FAILED,
+  HANDOFF,
   MAXOPTYPE
 };
 
 extern const char *kOperationString[MAXOPTYPE];
 
+///
+/// Whether op is one a workload issues as a transaction, and so may be read
+/// back from a trace or dataset file.
+///
+inline bool IsTransactionOperation(uint32_t op) {
+  return op <= DELETE || op == BADREAD;
+}
+
+class CoreWorkload;
+
+///
+/// A transaction whose operation and key have been chosen but which has not
+/// been issued yet.
+///
+struct PendingTransaction {
+  CoreWorkload *workload; // the workload, or phase, that chose it
+  Operation op;
+  uint64_t key_num;
+  std::string key;
+  uint32_t value_size; // bytes per written field, 0 to draw from the field length distribution
+};
+
+///
+/// Per-client state, created by CoreWorkload::InitThread and handed back on
+/// every operation issued by that client.
+///
+struct ThreadState {
+  int thread_id;
+  int thread_count;
+  uint64_t hotset_start; // first key of this client's private hot set
+  uint64_t load_next; // next key to load
+  uint64_t load_stride; // distance between the keys this client loads
+  uint64_t insert_next; // next key to insert, with disjoint key partitioning
+  uint64_t insert_limit; // last key of this client's partition that exists
+  uint64_t op_begin; // this client's share of the dataset or trace operations it replays
+  uint64_t op_end;
+  uint64_t op_next; // next operation to replay
+  uint64_t op_lap; // times this client has started its share over
+  // buffers reused across operations, so keys and values are not reallocated
+  std::string key;
+  std::vector<DB::Field> values;
+  std::vector<DB::Record> batch;
+  PendingTransaction txn;
+  std::vector<PendingTransaction> txns;
+  std::vector<std::string> batch_keys;
+  std::vector<std::vector<DB::Field>> batch_values;
+};
+
 class CoreWorkload {
  public:
   ///
@@ -82,6 +143,24 @@ class CoreWorkload {
   static const std::string WRITE_ALL_FIELDS_PROPERTY;
   static const std::string WRITE_ALL_FIELDS_DEFAULT;
 
+  ///
+  /// The name of the property for how read-modify-write transactions reach
+  /// the DB: "separate" (Read, then Update), "compound" (one
+  /// DB::ReadModifyWrite) or "cas" (Read, then DB::CompareAndSwap, again
+  /// until no other write came between). The default DB::ReadModifyWrite is
+  /// a Read then an Update; "cas" needs a DB that implements CompareAndSwap,
+  /// such as striped_db, which does both atomically in one lookup.
+  ///
+  static const std::string READMODIFYWRITE_METHOD_PROPERTY;
+  static const std::string READMODIFYWRITE_METHOD_DEFAULT;
+
+  ///
+  /// The name of the property for deciding whether insert transactions call
+  /// DB::InsertIfAbsent (true) or DB::Insert (false).
+  ///
+  static const std::string INSERT_IF_ABSENT_PROPERTY;
+  static const std::string INSERT_IF_ABSENT_DEFAULT;
+
   ///
   /// The name of the property for the proportion of read transactions.
   ///
@@ -119,6 +198,21 @@ class CoreWorkload {
   static const std::string READMODIFYWRITE_PROPORTION_PROPERTY;
   static const std::string READMODIFYWRITE_PROPORTION_DEFAULT;
 
+  ///
+  /// The name of the property for the proportion of delete transactions.
+  ///
+  static const std::string DELETE_PROPORTION_PROPERTY;
+  static const std::string DELETE_PROPORTION_DEFAULT;
+
+  ///
+  /// The name of the property for churn: deletes remove the oldest record,
+  /// at the rate of inserts unless deleteproportion is given, so the number
+  /// of live records stays constant, and other operations choose keys among
+  /// the live records.
+  ///
+  static const std::string CHURN_PROPERTY;
+  static const std::string CHURN_DEFAULT;
+
   ///
   /// The name of the property for the the distribution of request keys.
   /// Options are "uniform", "zipfian" and "latest".
@@ -175,67 +269,625 @@ class CoreWorkload {
   ///
   static const std::string ZIPFIAN_CONST_PROPERTY;
 
+  ///
+  /// Per-operation key distribution overrides.
+  /// REQUEST_DISTRIBUTION_PROPERTY and ZIPFIAN_CONST_PROPERTY prefixed with one of
+  /// these (e.g. "update.requestdistribution", "read.zipfian_const") give that
+  /// operation its own key chooser. Operations without an override share the global one.
+  ///
+  static const std::string READ_KEY_PREFIX;
+  static const std::string UPDATE_KEY_PREFIX;
+  static const std::string SCAN_KEY_PREFIX;
+  static const std::string READMODIFYWRITE_KEY_PREFIX;
+
+  ///
+  /// The name of the property for the size of each client's hot set, as a
+  /// fraction of recordcount. Zero disables per-client hot sets.
+  ///
+  static const std::string HOTSET_FRACTION_PROPERTY;
+  static const std::string HOTSET_FRACTION_DEFAULT;
+
+  ///
+  /// The name of the property for the fraction of key choices that go to the
+  /// client's own hot set. The rest follow the request distribution.
+  ///
+  static const std::string HOTSET_OPN_FRACTION_PROPERTY;
+  static const std::string HOTSET_OPN_FRACTION_DEFAULT;
+
+  ///
+  /// The name of the property for the fraction of each hot set that is shared
+  /// by all clients. The remainder is private to the client.
+  ///
+  static const std::string HOTSET_OVERLAP_PROPERTY;
+  static const std::string HOTSET_OVERLAP_DEFAULT;
+
+  ///
+  /// The name of the property for the number of hot keys, the first ones,
+  /// shared by all clients for write contention. Zero disables them.
+  ///
+  static const std::string HOTKEY_COUNT_PROPERTY;
+  static const std::string HOTKEY_COUNT_DEFAULT;
+
+  ///
+  /// The name of the property for the fraction of update and
+  /// read-modify-write key choices that go, uniformly, to the hot keys.
+  ///
+  static const std::string HOTKEY_FRACTION_PROPERTY;
+  static const std::string HOTKEY_FRACTION_DEFAULT;
+
+  ///
+  /// The name of the property for how keys are split between clients.
+  /// Options are "shared" (every client may touch every key) and "disjoint"
+  /// (client i owns the keys with key_num % threadcount == i, and loads,
+  /// inserts, updates and reads only those).
+  ///
+  static const std::string KEY_PARTITIONING_PROPERTY;
+  static const std::string KEY_PARTITIONING_DEFAULT;
+
+  ///
+  /// The name of the property for the fraction of reads that may go to any
+  /// partition when key partitioning is disjoint.
+  ///
+  static const std::string CROSS_PARTITION_READ_FRACTION_PROPERTY;
+  static const std::string CROSS_PARTITION_READ_FRACTION_DEFAULT;
+
+  ///
+  /// The name of the property for the number of transactions each client
+  /// thread interleaves, as coroutines that prefetch their key before issuing
+  /// the operation.
+  ///
+  static const std::string COROUTINES_PROPERTY;
+  static const std::string COROUTINES_DEFAULT;
+
+  ///
+  /// The name of the property for the number of records each loading client
+  /// passes to DB::BulkInsert at once. 1 inserts records one at a time.
+  ///
+  static const std::string LOAD_BATCH_SIZE_PROPERTY;
+  static const std::string LOAD_BATCH_SIZE_DEFAULT;
+
+  ///
+  /// The name of the property for the number of consecutive transactions
+  /// each client chooses at once. Runs of reads, and of updates, among them
+  /// go to DB::MultiRead and DB::MultiUpdate. 1 issues them one at a time.
+  ///
+  static const std::string BATCH_SIZE_PROPERTY;
+  static const std::string BATCH_SIZE_DEFAULT;
+
+  ///
+  /// The name of the property for a dataset file, written by WriteDataset,
+  /// to load records from and, if it holds operations, to replay them from.
+  ///
+  static const std::string DATASET_FILE_PROPERTY;
+
+  ///
+  /// The name of the property for a trace file to record the first
+  /// operationcount transactions to.
+  ///
+  static const std::string TRACE_RECORD_PROPERTY;
+
   ///
   /// Initialize the scenario.
   /// Called once, in the main client thread, before any operations are started.
   ///
   virtual void Init(const utils::Properties &p);
 
-  virtual bool DoInsert(DB &db);
-  virtual bool DoTransaction(DB &db);
+  ///
+  /// Initialize the scenario so that it shares the transaction insert key
+  /// sequence of another, already initialized workload. Used when several
+  /// workloads run against the same table at once. The record layout, key
+  /// range, hot set layout and key partitioning are those of key_space,
+  /// whatever p sets, so both choose keys from the table that was loaded.
+  ///
+  void InitSharingKeySpace(const utils::Properties &p, CoreWorkload &key_space);
+
+  ///
+  /// Switch running clients to the operation mix and key distributions given
+  /// by a new set of properties. As with InitSharingKeySpace, the record
+  /// layout, key range, hot set layout and key partitioning keep their
+  /// initial settings, since running clients laid out their state for them.
+  /// Not safe to call concurrently with itself.
+  ///
+  void Reconfigure(const utils::Properties &p);
+
+  ///
+  /// Initialize the state of one client.
+  /// Called once per client, before that client issues any operation.
+  ///
+  virtual ThreadState InitThread(int thread_id, int thread_count);
+
+  ///
+  /// Lays the private hot sets out per thread rather than per client, for
+  /// virtual clients: client c of InitThread gets the hot set of thread
+  /// c % thread_count, the thread serving it, and the hot sets only need to
+  /// fit for thread_count threads.
+  ///
+  void SetHotSetThreads(int thread_count) { hotset_threads_ = thread_count; }
+
+  ///
+  /// Number of records client thread_id of thread_count loads. Together the
+  /// clients load keys insertstart to insertstart + recordcount - 1.
+  ///
+  uint64_t LoadCount(int thread_id, int thread_count) const;
+
+  ///
+  /// Loads the client's next record, or issues its next transaction. With
+  /// clientloop=static, clients call the Execute methods below instead, so
+  /// a subclass that changes what transactions do must override
+  /// ChooseTransaction (and InitThread), not these.
+  ///
+  virtual bool DoInsert(DB &db, ThreadState &state);
+  virtual bool DoTransaction(DB &db, ThreadState &state);
+
+  ///
+  /// Loads the client's next count records with one DB::BulkInsert call.
+  ///
+  virtual bool DoBulkInsert(DB &db, ThreadState &state, int count);
+
+  ///
+  /// Chooses the client's next count transactions and issues them in order,
+  /// each run of two or more reads, or updates, with one DB::MultiRead or
+  /// DB::MultiUpdate call.
+  ///
+  virtual bool DoTransactionBatch(DB &db, ThreadState &state, int count);
+
+  ///
+  /// DoInsert, DoBulkInsert, DoTransaction and DoTransactionBatch for a known
+  /// DB type. Calls into a final DB class bind statically and can be inlined
+  /// into the client loop. Overrides of the Do methods are bypassed.
+  ///
+  template <typename DBType>
+  bool ExecuteInsert(DBType &db, ThreadState &state);
+  template <typename DBType>
+  bool ExecuteBulkInsert(DBType &db, ThreadState &state, int count);
+  template <typename DBType>
+  bool ExecuteTransaction(DBType &db, ThreadState &state);
+  template <typename DBType>
+  bool ExecuteTransactionBatch(DBType &db, ThreadState &state, int count);
+
+  ///
+  /// ExecuteTransaction split in two, for clients that interleave several
+  /// transactions. StartTransaction chooses the operation and key and asks the
+  /// DB to prefetch the record. FinishTransaction issues the operation.
+  ///
+  template <typename DBType>
+  void StartTransaction(DBType &db, ThreadState &state, PendingTransaction &txn);
+  template <typename DBType>
+  bool FinishTransaction(DBType &db, ThreadState &state, PendingTransaction &txn);
+
+  ///
+  /// Chooses the operation and key of the next transaction.
+  ///
+  virtual void ChooseTransaction(ThreadState &state, PendingTransaction &txn);
+
+  ///
+  /// Writes the records of keys 0 to recordcount - 1, and op_count operations
+  /// chosen as by a single client, to a dataset file.
+  ///
+  void WriteDataset(const std::string &path, uint64_t op_count);
+
+  ///
+  /// Issues a transaction that FinishTransaction already completed against
+  /// another DB, leaving the key sequences untouched.
+  ///
+  template <typename DBType>
+  bool ReplayTransaction(DBType &db, const PendingTransaction &txn);
+
+  ///
+  /// Number of transactions each client thread interleaves, 1 if disabled.
+  ///
+  int coroutines() const { return coroutines_; }
+
+  ///
+  /// Number of records each loading client inserts at once, 1 if not batched.
+  ///
+  int load_batch_size() const { return load_batch_size_; }
+
+  ///
+  /// Number of transactions each client chooses at once, 1 if not batched.
+  ///
+  int batch_size() const { return batch_size_; }
+
+  ///
+  /// The recorder of trace.record, or nullptr if not recording.
+  ///
+  TraceRecorder *trace_recorder() const { return recorder_.get(); }
 
   bool read_all_fields() const { return read_all_fields_; }
   bool write_all_fields() const { return write_all_fields_; }
 
   CoreWorkload() :
       field_count_(0), read_all_fields_(false), write_all_fields_(false),
-      field_len_generator_(nullptr), key_chooser_(nullptr), field_chooser_(nullptr),
-      scan_len_chooser_(nullptr), insert_key_sequence_(nullptr),
-      transaction_insert_key_sequence_(nullptr), ordered_inserts_(true), record_count_(0) {
+      rmw_method_(kRmwSeparate), insert_if_absent_(false),
+      field_len_generator_(nullptr), key_chooser_(nullptr), op_key_chooser_{},
+      field_chooser_(nullptr), scan_len_chooser_(nullptr),
+      transaction_insert_key_sequence_(nullptr), delete_key_sequence_(nullptr),
+      shares_key_sequences_(false), churn_(false),
+      ordered_inserts_(true), record_count_(0),
+      insert_start_(0), hotset_size_(0), hotset_shared_(0), hotset_threads_(0),
+      hotset_opn_fraction_(0),
+      hotkey_count_(0), hotkey_fraction_(0),
+      disjoint_partitions_(false), cross_partition_read_fraction_(0), coroutines_(1),
+      load_batch_size_(1), batch_size_(1), replay_ops_(false), phase_(nullptr) {
   }
 
   virtual ~CoreWorkload() {
+    for (auto phase : phases_) {
+      delete phase;
+    }
     delete field_len_generator_;
+    for (int i = 0; i < MAXOPTYPE; i++) {
+      if (op_key_chooser_[i] != key_chooser_) {
+        delete op_key_chooser_[i];
+      }
+    }
     delete key_chooser_;
     delete field_chooser_;
     delete scan_len_chooser_;
-    delete insert_key_sequence_;
-    delete transaction_insert_key_sequence_;
+    if (!shares_key_sequences_) {
+      delete transaction_insert_key_sequence_;
+      delete delete_key_sequence_;
+    }
   }
 
  protected:
   static Generator<uint64_t> *GetFieldLenGenerator(const utils::Properties &p);
-  std::string BuildKeyName(uint64_t key_num);
-  void BuildValues(std::vector<DB::Field> &values);
-  void BuildSingleValue(std::vector<DB::Field> &update);
-
-  uint64_t NextTransactionKeyNum();
+  Generator<uint64_t> *CreateKeyChooser(const utils::Properties &p, const std::string &request_dist,
+                                        const std::string &zipfian_const_property,
+                                        double insert_proportion);
+  void BuildKeyName(uint64_t key_num, std::string &key);
+  void BuildValues(std::vector<DB::Field> &values, uint64_t value_size = 0);
+  void BuildSingleValue(std::vector<DB::Field> &update, uint64_t value_size = 0);
+
+  uint64_t NextLoadKeyNum(ThreadState &state);
+  void LoadRecord(uint64_t key_num, std::string &key, std::vector<DB::Field> &values);
+  void AcknowledgeInsert(ThreadState &state, uint64_t key_num);
+  uint64_t NextTransactionKeyNum(Operation op, ThreadState &state);
   std::string NextFieldName();
-
-  DB::Status TransactionRead(DB &db);
-  DB::Status TransactionReadModifyWrite(DB &db);
-  DB::Status TransactionScan(DB &db);
-  DB::Status TransactionBadRead(DB &db);
-  DB::Status TransactionUpdate(DB &db);
-  DB::Status TransactionInsert(DB &db);
+  template <typename DBType>
+  DB::Status IssueTransaction(DBType &db, const PendingTransaction &txn);
+  template <typename DBType>
+  DB::Status TransactionRead(DBType &db, const PendingTransaction &txn);
+  template <typename DBType>
+  DB::Status TransactionReadModifyWrite(DBType &db, const PendingTransaction &txn);
+  template <typename DBType>
+  DB::Status TransactionScan(DBType &db, const PendingTransaction &txn);
+  template <typename DBType>
+  DB::Status TransactionBadRead(DBType &db, const PendingTransaction &txn);
+  template <typename DBType>
+  DB::Status TransactionUpdate(DBType &db, const PendingTransaction &txn);
+  template <typename DBType>
+  DB::Status TransactionInsert(DBType &db, const PendingTransaction &txn);
+  template <typename DBType>
+  DB::Status TransactionDelete(DBType &db, const PendingTransaction &txn);
+  template <typename DBType>
+  DB::Status TransactionMultiRead(DBType &db, ThreadState &state,
+                                  std::span<const PendingTransaction> txns);
+  template <typename DBType>
+  DB::Status TransactionMultiUpdate(DBType &db, ThreadState &state,
+                                    std::span<const PendingTransaction> txns);
 
   std::string table_name_;
   int field_count_;
   std::string field_prefix_;
   bool read_all_fields_;
   bool write_all_fields_;
+  enum { kRmwSeparate, kRmwCompound, kRmwCas } rmw_method_;
+  bool insert_if_absent_;
   Generator<uint64_t> *field_len_generator_;
   DiscreteGenerator<Operation> op_chooser_;
   Generator<uint64_t> *key_chooser_; // transaction key gen
+  Generator<uint64_t> *op_key_chooser_[MAXOPTYPE]; // per-op key gen, defaults to key_chooser_
   Generator<uint64_t> *field_chooser_;
   Generator<uint64_t> *scan_len_chooser_;
-  CounterGenerator *insert_key_sequence_; // load insert key gen
   AcknowledgedCounterGenerator *transaction_insert_key_sequence_; // transaction insert key gen
+  CounterGenerator *delete_key_sequence_; // oldest live key, with churn
+  bool shares_key_sequences_; // key sequences are owned by another workload
+  bool churn_;
   bool ordered_inserts_;
-  size_t record_count_;
+  uint64_t record_count_;
+  uint64_t insert_start_;
   int zero_padding_;
+  uint64_t hotset_size_; // keys per client hot set, 0 if disabled
+  uint64_t hotset_shared_; // leading hot set keys shared by all clients
+  int hotset_threads_; // owners of private hot sets, 0 for one per client
+  double hotset_opn_fraction_;
+  uint64_t hotkey_count_; // hot keys shared by all writers, 0 if disabled
+  double hotkey_fraction_;
+  bool disjoint_partitions_;
+  double cross_partition_read_fraction_;
+  int coroutines_;
+  int load_batch_size_;
+  int batch_size_;
+  std::shared_ptr<const Dataset> dataset_; // records to load, and operations to replay, if set
+  bool replay_ops_; // transactions replay operations chosen beforehand
+  std::shared_ptr<TraceRecorder> recorder_;
+  std::map<std::string, std::string> layout_props_; // settings workloads sharing the key space keep
+  std::atomic<CoreWorkload *> phase_; // set by Reconfigure, serves transactions if not null
+  std::vector<CoreWorkload *> phases_; // all phases, kept alive for running clients
 };
 
+inline uint64_t CoreWorkload::NextLoadKeyNum(ThreadState &state) {
+  uint64_t key_num = state.load_next;
+  state.load_next += state.load_stride;
+  return key_num;
+}
+
+inline void CoreWorkload::LoadRecord(uint64_t key_num, std::string &key,
+                                     std::vector<DB::Field> &values) {
+  if (dataset_) {
+    dataset_->GetRecord(key_num, key, values);
+  } else {
+    BuildKeyName(key_num, key);
+    BuildValues(values);
+  }
+}
+
+inline void CoreWorkload::AcknowledgeInsert(ThreadState &state, uint64_t key_num) {
+  if (disjoint_partitions_) {
+    state.insert_limit = std::max(state.insert_limit, key_num);
+  } else {
+    transaction_insert_key_sequence_->Acknowledge(key_num);
+  }
+}
+
+template <typename DBType>
+inline bool CoreWorkload::ExecuteInsert(DBType &db, ThreadState &state) {
+  LoadRecord(NextLoadKeyNum(state), state.key, state.values);
+  return db.Insert(table_name_, state.key, state.values) == DB::kOK;
+}
+
+template <typename DBType>
+inline bool CoreWorkload::ExecuteBulkInsert(DBType &db, ThreadState &state, int count) {
+  state.batch.resize(count);
+  for (auto &record : state.batch) {
+    LoadRecord(NextLoadKeyNum(state), record.key, record.values);
+  }
+  return db.BulkInsert(table_name_, std::span<DB::Record>(state.batch)) == DB::kOK;
+}
+
+template <typename DBType>
+inline bool CoreWorkload::ExecuteTransaction(DBType &db, ThreadState &state) {
+  ChooseTransaction(state, state.txn);
+  return FinishTransaction(db, state, state.txn);
+}
+
+template <typename DBType>
+inline bool CoreWorkload::ExecuteTransactionBatch(DBType &db, ThreadState &state, int count) {
+  state.txns.resize(count);
+  for (auto &txn : state.txns) {
+    ChooseTransaction(state, txn);
+  }
+
+  bool ok = true;
+  for (int i = 0; i < count;) {
+    const PendingTransaction &txn = state.txns[i];
+    int end = i + 1;
+    if (txn.op == READ || txn.op == UPDATE) {
+      // a phase switch ends the run, since each phase issues its own
+      while (end < count && state.txns[end].op == txn.op &&
+             state.txns[end].workload == txn.workload) {
+        end++;
+      }
+    }
+    if (end - i == 1) {
+      ok = FinishTransaction(db, state, state.txns[i]) && ok;
+    } else {
+      std::span<const PendingTransaction> run(state.txns.data() + i, end - i);
+      DB::Status s = txn.op == READ ? txn.workload->TransactionMultiRead(db, state, run)
+                                    : txn.workload->TransactionMultiUpdate(db, state, run);
+      ok = (s == DB::kOK) && ok;
+    }
+    i = end;
+  }
+  return ok;
+}
+
+template <typename DBType>
+inline void CoreWorkload::StartTransaction(DBType &db, ThreadState &state,
+                                           PendingTransaction &txn) {
+  ChooseTransaction(state, txn);
+  db.Prefetch(table_name_, txn.key);
+}
+
+template <typename DBType>
+inline bool CoreWorkload::FinishTransaction(DBType &db, ThreadState &state,
+                                            PendingTransaction &txn) {
+  if (txn.workload != this) {
+    return txn.workload->FinishTransaction(db, state, txn);
+  }
+
+  DB::Status status = IssueTransaction(db, txn);
+  // replayed inserts name keys of the dataset, not of the insert key sequences
+  if (txn.op == INSERT && !replay_ops_) {
+    AcknowledgeInsert(state, txn.key_num);
+  }
+  return (status == DB::kOK);
+}
+
+template <typename DBType>
+inline bool CoreWorkload::ReplayTransaction(DBType &db, const PendingTransaction &txn) {
+  if (txn.workload != this) {
+    return txn.workload->ReplayTransaction(db, txn);
+  }
+  return (IssueTransaction(db, txn) == DB::kOK);
+}
+
+template <typename DBType>
+inline DB::Status CoreWorkload::IssueTransaction(DBType &db, const PendingTransaction &txn) {
+  switch (txn.op) {
+  case READ:
+    return TransactionRead(db, txn);
+  case UPDATE:
+    return TransactionUpdate(db, txn);
+  case INSERT:
+    return TransactionInsert(db, txn);
+  case SCAN:
+    return TransactionScan(db, txn);
+  case BADREAD:
+    return TransactionBadRead(db, txn);
+  case READMODIFYWRITE:
+    return TransactionReadModifyWrite(db, txn);
+  case DELETE:
+    return TransactionDelete(db, txn);
+  default:
+    throw utils::Exception("Operation request is not recognized!");
+  }
+}
+
+template <typename DBType>
+inline DB::Status CoreWorkload::TransactionRead(DBType &db, const PendingTransaction &txn) {
+  std::vector<DB::Field> result;
+  if (!read_all_fields()) {
+    std::vector<std::string> fields;
+    fields.push_back(NextFieldName());
+    return db.Read(table_name_, txn.key, &fields, result);
+  } else {
+    return db.Read(table_name_, txn.key, NULL, result);
+  }
+}
+
+template <typename DBType>
+inline DB::Status CoreWorkload::TransactionReadModifyWrite(DBType &db,
+                                                           const PendingTransaction &txn) {
+  std::vector<DB::Field> values;
+  if (rmw_method_ == kRmwCompound) {
+    if (write_all_fields()) {
+      BuildValues(values, txn.value_size);
+    } else {
+      BuildSingleValue(values, txn.value_size);
+    }
+    std::vector<std::string> fields;
+    if (!read_all_fields()) {
+      fields.push_back(NextFieldName());
+    }
+    return db.ReadModifyWrite(table_name_, txn.key, read_all_fields() ? NULL : &fields,
+                              [&values](std::vector<DB::Field> &record) {
+                                record = std::move(values);
+                              });
+  } else if (rmw_method_ == kRmwCas) {
+    // one Read for the first expected record; a failed swap hands back the
+    // current one, so retries go straight to the next swap
+    std::vector<DB::Field> expected;
+    DB::Status s = db.Read(table_name_, txn.key, NULL, expected);
+    if (s != DB::kOK) {
+      return s;
+    }
+    if (write_all_fields()) {
+      BuildValues(values, txn.value_size);
+    } else {
+      BuildSingleValue(values, txn.value_size);
+    }
+    do {
+      s = db.CompareAndSwap(table_name_, txn.key, expected, values);
+    } while (s == DB::kConflict);
+    if (s == DB::kNotImplemented) {
+      throw utils::Exception("readmodifywrite.method=cas needs a binding that implements "
+                             "DB::CompareAndSwap");
+    }
+    return s;
+  }
+
+  std::vector<DB::Field> result;
+
+  if (!read_all_fields()) {
+    std::vector<std::string> fields;
+    fields.push_back(NextFieldName());
+    db.Read(table_name_, txn.key, &fields, result);
+  } else {
+    db.Read(table_name_, txn.key, NULL, result);
+  }
+
+  if (write_all_fields()) {
+    BuildValues(values, txn.value_size);
+  } else {
+    BuildSingleValue(values, txn.value_size);
+  }
+  return db.Update(table_name_, txn.key, values);
+}
+
+template <typename DBType>
+inline DB::Status CoreWorkload::TransactionScan(DBType &db, const PendingTransaction &txn) {
+  int len = scan_len_chooser_->Next();
+  std::vector<std::vector<DB::Field>> result;
+  if (!read_all_fields()) {
+    std::vector<std::string> fields;
+    fields.push_back(NextFieldName());
+    return db.Scan(table_name_, txn.key, len, &fields, result);
+  } else {
+    return db.Scan(table_name_, txn.key, len, NULL, result);
+  }
+}
+
+template <typename DBType>
+inline DB::Status CoreWorkload::TransactionBadRead(DBType &db, const PendingTransaction &txn) {
+  std::vector<DB::Field> result;
+  return db.Read(table_name_, txn.key, NULL, result);
+}
+
+template <typename DBType>
+inline DB::Status CoreWorkload::TransactionUpdate(DBType &db, const PendingTransaction &txn) {
+  std::vector<DB::Field> values;
+  if (write_all_fields()) {
+    BuildValues(values, txn.value_size);
+  } else {
+    BuildSingleValue(values, txn.value_size);
+  }
+  return db.Update(table_name_, txn.key, values);
+}
+
+template <typename DBType>
+inline DB::Status CoreWorkload::TransactionInsert(DBType &db, const PendingTransaction &txn) {
+  std::vector<DB::Field> values;
+  BuildValues(values, txn.value_size);
+  if (insert_if_absent_) {
+    return db.InsertIfAbsent(table_name_, txn.key, values);
+  }
+  return db.Insert(table_name_, txn.key, values);
+}
+
+template <typename DBType>
+inline DB::Status CoreWorkload::TransactionDelete(DBType &db, const PendingTransaction &txn) {
+  return db.Delete(table_name_, txn.key);
+}
+
+template <typename DBType>
+inline DB::Status CoreWorkload::TransactionMultiRead(DBType &db, ThreadState &state,
+                                                     std::span<const PendingTransaction> txns) {
+  // keys of earlier batches are overwritten in place, keeping their storage
+  state.batch_keys.resize(txns.size());
+  for (size_t i = 0; i < txns.size(); i++) {
+    state.batch_keys[i].assign(txns[i].key);
+  }
+  std::vector<std::vector<DB::Field>> results;
+  if (!read_all_fields()) {
+    std::vector<std::string> fields;
+    fields.push_back(NextFieldName());
+    return db.MultiRead(table_name_, state.batch_keys, &fields, results);
+  } else {
+    return db.MultiRead(table_name_, state.batch_keys, NULL, results);
+  }
+}
+
+template <typename DBType>
+inline DB::Status CoreWorkload::TransactionMultiUpdate(DBType &db, ThreadState &state,
+                                                       std::span<const PendingTransaction> txns) {
+  // keys and values of earlier batches are overwritten in place, keeping
+  // their storage
+  state.batch_keys.resize(txns.size());
+  state.batch_values.resize(txns.size());
+  for (size_t i = 0; i < txns.size(); i++) {
+    state.batch_keys[i].assign(txns[i].key);
+    if (write_all_fields()) {
+      BuildValues(state.batch_values[i], txns[i].value_size);
+    } else {
+      BuildSingleValue(state.batch_values[i], txns[i].value_size);
+    }
+  }
+  return db.MultiUpdate(table_name_, state.batch_keys,
+                        std::span<std::vector<DB::Field>>(state.batch_values));
+}
+
 } // ycsbc
 
 #endif // YCSB_C_CORE_WORKLOAD_H_
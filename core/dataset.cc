@@ -0,0 +1,166 @@
+//
+//  dataset.cc
+//  YCSB-cpp
+//
+
+#include "dataset.h"
+
+#include <cstring>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "core_workload.h"
+#include "utils/utils.h"
+
+namespace ycsbc {
+
+namespace {
+
+const char kDatasetMagic[8] = {'Y', 'C', 'S', 'B', 'D', 'A', 'T', '1'};
+
+void WriteBytes(std::ofstream &out, const std::string &bytes) {
+  uint32_t length = bytes.size();
+  out.write(reinterpret_cast<const char *>(&length), sizeof(length));
+  out.write(bytes.data(), length);
+}
+
+} // namespace
+
+DatasetWriter::DatasetWriter(const std::string &path, const std::vector<std::string> &field_names,
+                             int zero_padding, bool ordered_inserts)
+    : out_(path, std::ios::binary | std::ios::trunc), header_{}, index_written_(false) {
+  if (!out_.is_open()) {
+    throw utils::Exception("failed to open: " + path);
+  }
+  std::memcpy(header_.magic, kDatasetMagic, sizeof(kDatasetMagic));
+  header_.field_count = field_names.size();
+  header_.zero_padding = zero_padding;
+  header_.ordered_inserts = ordered_inserts;
+  // the header is written again, complete, by Finish
+  out_.write(reinterpret_cast<const char *>(&header_), sizeof(header_));
+  for (auto &name : field_names) {
+    WriteBytes(out_, name);
+  }
+}
+
+void DatasetWriter::AddRecord(const std::string &key, const std::vector<DB::Field> &values) {
+  if (index_written_) {
+    throw utils::Exception("dataset records must precede operations");
+  }
+  if (values.size() != header_.field_count) {
+    throw utils::Exception("dataset record with a different number of fields");
+  }
+  offsets_.push_back(out_.tellp());
+  WriteBytes(out_, key);
+  for (auto &field : values) {
+    WriteBytes(out_, field.value);
+  }
+  header_.record_count++;
+}
+
+void DatasetWriter::WriteIndex() {
+  offsets_.push_back(out_.tellp());
+  // keep the index and operations 8-byte aligned in the mapping
+  while (offsets_.back() % sizeof(uint64_t) != 0) {
+    out_.put(0);
+    offsets_.back()++;
+  }
+  header_.index_offset = offsets_.back();
+  out_.write(reinterpret_cast<const char *>(offsets_.data()), offsets_.size() * sizeof(uint64_t));
+  header_.ops_offset = out_.tellp();
+  offsets_.clear();
+  offsets_.shrink_to_fit();
+  index_written_ = true;
+}
+
+void DatasetWriter::AddOp(int op, uint64_t key_num) {
+  if (!index_written_) {
+    WriteIndex();
+  }
+  DatasetOp entry{key_num, static_cast<uint32_t>(op), 0};
+  out_.write(reinterpret_cast<const char *>(&entry), sizeof(entry));
+  header_.op_count++;
+}
+
+void DatasetWriter::Finish() {
+  if (!index_written_) {
+    WriteIndex();
+  }
+  out_.seekp(0);
+  out_.write(reinterpret_cast<const char *>(&header_), sizeof(header_));
+  out_.close();
+  if (out_.fail()) {
+    throw utils::Exception("failed to write dataset");
+  }
+}
+
+Dataset::Dataset(const std::string &path) {
+  int fd = open(path.c_str(), O_RDONLY);
+  if (fd < 0) {
+    throw utils::Exception("failed to open: " + path);
+  }
+  struct stat st;
+  if (fstat(fd, &st) != 0 || static_cast<size_t>(st.st_size) < sizeof(DatasetHeader)) {
+    close(fd);
+    throw utils::Exception("not a dataset file: " + path);
+  }
+  size_ = st.st_size;
+  // populate the mapping up front, so loading does not fault the file in
+  void *data = mmap(nullptr, size_, PROT_READ, MAP_PRIVATE | MAP_POPULATE, fd, 0);
+  close(fd);
+  if (data == MAP_FAILED) {
+    throw utils::Exception("failed to map: " + path);
+  }
+  data_ = static_cast<const char *>(data);
+  header_ = reinterpret_cast<const DatasetHeader *>(data_);
+  if (std::memcmp(header_->magic, kDatasetMagic, sizeof(kDatasetMagic)) != 0 ||
+      header_->ops_offset + header_->op_count * sizeof(DatasetOp) > size_) {
+    munmap(data, size_);
+    throw utils::Exception("not a dataset file: " + path);
+  }
+
+  const char *p = data_ + sizeof(DatasetHeader);
+  for (uint32_t i = 0; i < header_->field_count; i++) {
+    uint32_t length;
+    std::memcpy(&length, p, sizeof(length));
+    field_names_.emplace_back(p + sizeof(length), length);
+    p += sizeof(length) + length;
+  }
+  index_ = reinterpret_cast<const uint64_t *>(data_ + header_->index_offset);
+  ops_ = reinterpret_cast<const DatasetOp *>(data_ + header_->ops_offset);
+  for (uint64_t i = 0; i < header_->op_count; i++) {
+    if (!IsTransactionOperation(ops_[i].op)) {
+      const std::string message = "invalid operation " + std::to_string(ops_[i].op) +
+                                  " at op " + std::to_string(i) + " of dataset: " + path;
+      munmap(data, size_);
+      throw utils::Exception(message);
+    }
+  }
+}
+
+Dataset::~Dataset() {
+  munmap(const_cast<char *>(data_), size_);
+}
+
+void Dataset::GetRecord(uint64_t index, std::string &key, std::vector<DB::Field> &values) const {
+  const char *p = data_ + index_[index];
+  uint32_t length;
+  std::memcpy(&length, p, sizeof(length));
+  key.assign(p + sizeof(length), length);
+  p += sizeof(length) + length;
+
+  values.resize(field_names_.size());
+  for (size_t i = 0; i < field_names_.size(); i++) {
+    if (values[i].name != field_names_[i]) {
+      values[i].name = field_names_[i];
+    }
+    std::memcpy(&length, p, sizeof(length));
+    values[i].value.assign(p + sizeof(length), length);
+    p += sizeof(length) + length;
+  }
+}
+
+} // ycsbc
@@ -0,0 +1,110 @@
+//
+//  dataset.h
+//  YCSB-cpp
+//
+//  Pre-generated records and operations, written to a file once and mapped
+//  into memory by every later run.
+//
+
+#ifndef YCSB_C_DATASET_H_
+#define YCSB_C_DATASET_H_
+
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "db.h"
+
+namespace ycsbc {
+
+///
+/// Layout of a dataset file, in host byte order:
+///
+///   DatasetHeader
+///   field names     field_count x (uint32_t length, bytes)
+///   records         per record: uint32_t key length, key bytes, then per
+///                   field uint32_t value length, value bytes
+///   record index    record_count + 1 uint64_t file offsets, of each record
+///                   and of the end of the last one
+///   operations      op_count x DatasetOp
+///
+struct DatasetHeader {
+  char magic[8];
+  uint64_t record_count;
+  uint64_t op_count;
+  uint64_t index_offset;
+  uint64_t ops_offset;
+  uint32_t field_count;
+  uint32_t zero_padding; // key format the operations' key numbers map through
+  uint32_t ordered_inserts;
+  uint32_t reserved;
+};
+
+///
+/// One transaction: its operation and the number its key was built from.
+///
+struct DatasetOp {
+  uint64_t key_num;
+  uint32_t op;
+  uint32_t reserved;
+};
+
+///
+/// Writes a dataset file. Records must all be added before any operation.
+///
+class DatasetWriter {
+ public:
+  DatasetWriter(const std::string &path, const std::vector<std::string> &field_names,
+                int zero_padding, bool ordered_inserts);
+  void AddRecord(const std::string &key, const std::vector<DB::Field> &values);
+  void AddOp(int op, uint64_t key_num);
+  ///
+  /// Writes the index and the header. No records or operations may follow.
+  ///
+  void Finish();
+
+ private:
+  void WriteIndex();
+
+  std::ofstream out_;
+  DatasetHeader header_;
+  std::vector<uint64_t> offsets_;
+  bool index_written_;
+};
+
+///
+/// A dataset file mapped read-only into memory. Records and operations are
+/// read straight from the mapping.
+///
+class Dataset {
+ public:
+  explicit Dataset(const std::string &path);
+  ~Dataset();
+  Dataset(const Dataset &) = delete;
+  Dataset &operator=(const Dataset &) = delete;
+
+  uint64_t record_count() const { return header_->record_count; }
+  uint64_t op_count() const { return header_->op_count; }
+  int field_count() const { return header_->field_count; }
+  int zero_padding() const { return header_->zero_padding; }
+  bool ordered_inserts() const { return header_->ordered_inserts != 0; }
+
+  ///
+  /// Copies record index into key and values, reusing their storage.
+  ///
+  void GetRecord(uint64_t index, std::string &key, std::vector<DB::Field> &values) const;
+  const DatasetOp &GetOp(uint64_t index) const { return ops_[index]; }
+
+ private:
+  const char *data_;
+  size_t size_;
+  const DatasetHeader *header_;
+  std::vector<std::string> field_names_;
+  const uint64_t *index_;
+  const DatasetOp *ops_;
+};
+
+} // ycsbc
+
+#endif // YCSB_C_DATASET_H_
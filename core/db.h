@@ -11,6 +11,9 @@
 
 #include "utils/properties.h"
 
+#include <algorithm>
+#include <functional>
+#include <span>
 #include <vector>
 #include <string>
 
@@ -26,11 +29,16 @@ class DB {
     std::string name;
     std::string value;
   };
+  struct Record {
+    std::string key;
+    std::vector<Field> values;
+  };
   enum Status {
     kOK = 0,
     kError,
     kNotFound,
-    kNotImplemented
+    kNotImplemented,
+    kConflict
   };
   ///
   /// Initializes any state for accessing this DB.
@@ -92,6 +100,134 @@ class DB {
   virtual Status Insert(const std::string &table, const std::string &key,
                      std::vector<Field> &values) = 0;
   ///
+  /// Inserts a batch of records, for loading. An implementation may presize
+  /// its table for the batch or insert the records in one step. By default,
+  /// inserts them one at a time.
+  ///
+  /// @param table The name of the table.
+  /// @param records The records to insert.
+  /// @return Zero if every record was inserted, else the first error code.
+  ///
+  virtual Status BulkInsert(const std::string &table, std::span<Record> records) {
+    Status result = kOK;
+    for (auto &record : records) {
+      Status s = Insert(table, record.key, record.values);
+      if (result == kOK) {
+        result = s;
+      }
+    }
+    return result;
+  }
+  ///
+  /// Reads a batch of records. An implementation may hash all keys and
+  /// start loading their buckets before probing any of them. By default,
+  /// prefetches every record and then reads them one at a time.
+  ///
+  /// @param table The name of the table.
+  /// @param keys The keys of the records to read.
+  /// @param fields The list of fields to read, or NULL for all of them.
+  /// @param results One vector of field/value pairs per key, appended to.
+  /// @return Zero if every record was read, else the first error code.
+  ///
+  virtual Status MultiRead(const std::string &table, std::span<const std::string> keys,
+                           const std::vector<std::string> *fields,
+                           std::vector<std::vector<Field>> &results) {
+    for (const auto &key : keys) {
+      Prefetch(table, key);
+    }
+    Status result = kOK;
+    for (const auto &key : keys) {
+      results.emplace_back();
+      Status s = Read(table, key, fields, results.back());
+      if (result == kOK) {
+        result = s;
+      }
+    }
+    return result;
+  }
+  ///
+  /// Updates a batch of records, keys[i] with values[i]. By default,
+  /// prefetches every record and then updates them one at a time.
+  ///
+  /// @param table The name of the table.
+  /// @param keys The keys of the records to write.
+  /// @param values One vector of field/value pairs per key.
+  /// @return Zero if every record was updated, else the first error code.
+  ///
+  virtual Status MultiUpdate(const std::string &table, std::span<const std::string> keys,
+                             std::span<std::vector<Field>> values) {
+    for (const auto &key : keys) {
+      Prefetch(table, key);
+    }
+    Status result = kOK;
+    for (size_t i = 0; i < keys.size(); i++) {
+      Status s = Update(table, keys[i], values[i]);
+      if (result == kOK) {
+        result = s;
+      }
+    }
+    return result;
+  }
+  ///
+  /// Reads a record, lets modify change its field/value pairs, and writes
+  /// them back. An implementation may do so atomically, in one lookup. By
+  /// default, calls Read and then Update, so other writes may come between.
+  ///
+  /// @param table The name of the table.
+  /// @param key The key of the record to modify.
+  /// @param fields The list of fields to read, or NULL for all of them.
+  /// @param modify Turns the field/value pairs read into those to write.
+  /// @return Zero on success, or a non-zero error code on error/record-miss.
+  ///
+  virtual Status ReadModifyWrite(const std::string &table, const std::string &key,
+                                 const std::vector<std::string> *fields,
+                                 const std::function<void(std::vector<Field> &)> &modify) {
+    std::vector<Field> values;
+    Status s = Read(table, key, fields, values);
+    if (s != kOK) {
+      return s;
+    }
+    modify(values);
+    return Update(table, key, values);
+  }
+  ///
+  /// Inserts a record unless one with the key exists. By default, calls
+  /// Read and then Insert, which is not atomic.
+  ///
+  /// @param table The name of the table.
+  /// @param key The key of the record to insert.
+  /// @param values A vector of field/value pairs to insert in the record.
+  /// @return Zero if inserted, kConflict if the key exists, else an error code.
+  ///
+  virtual Status InsertIfAbsent(const std::string &table, const std::string &key,
+                                std::vector<Field> &values) {
+    std::vector<Field> current;
+    Status s = Read(table, key, NULL, current);
+    if (s == kOK) {
+      return kConflict;
+    } else if (s != kNotFound) {
+      return s;
+    }
+    return Insert(table, key, values);
+  }
+  ///
+  /// Updates a record if all its field/value pairs equal expected, as Read
+  /// returns them, atomically. On a mismatch, sets expected to the record's
+  /// current field/value pairs, so a caller can retry without another Read.
+  /// Not implemented by default: the compare and the write must be one step.
+  ///
+  /// @param table The name of the table.
+  /// @param key The key of the record to write.
+  /// @param expected The field/value pairs the record must hold; on kConflict,
+  ///        those it holds.
+  /// @param values A vector of field/value pairs to update in the record.
+  /// @return Zero if updated, kConflict if the record differs, else an error code.
+  ///
+  virtual Status CompareAndSwap(const std::string &, const std::string &,
+                                std::vector<Field> &, std::vector<Field> &) {
+    return kNotImplemented;
+  }
+  ///
   /// Deletes a record from the database.
   ///
   /// @param table The name of the table.
@@ -99,6 +235,15 @@ class DB {
   /// @return Zero on success, a non-zero error code on error.
   ///
   virtual Status Delete(const std::string &table, const std::string &key) = 0;
+  ///
+  /// Hints that the record is about to be accessed. An implementation may
+  /// start loading the memory a lookup of the key will touch and return
+  /// without waiting for it. Does nothing by default.
+  ///
+  /// @param table The name of the table.
+  /// @param key The key of the record.
+  ///
+  virtual void Prefetch(const std::string &, const std::string &) { }
 
   virtual ~DB() { }
 
@@ -9,6 +9,8 @@
 #include "db_factory.h"
 #include "basic_db.h"
 #include "db_wrapper.h"
+#include "null_db.h"
+#include "striped_db.h"
 
 #include "gsm_db/gsm_db.h"
 #include "gsm_diom_db/gsm_diom_db.h"
@@ -22,49 +24,82 @@ namespace ycsbc {
 
 namespace {
 
-bool ojdkchm_db_registered = DBFactory::RegisterDB(
-    "ojdkchm_db", []() -> DB * { return new ojdkchm_db(); });
+bool ojdkchm_db_registered = DBFactory::RegisterDB<ojdkchm_db>("ojdkchm_db");
 
-bool ojdkchm_oa_db_registered = DBFactory::RegisterDB(
-    "ojdkchm_oa_db", []() -> DB * { return new ojdkchm_oa_db(); });
+bool ojdkchm_oa_db_registered = DBFactory::RegisterDB<ojdkchm_oa_db>("ojdkchm_oa_db");
 
-bool rwl_db_registered =
-    DBFactory::RegisterDB("rwl_db", []() -> DB * { return new rwl_db(); });
+bool rwl_db_registered = DBFactory::RegisterDB<rwl_db>("rwl_db");
 
-bool gsm_db_registered =
-    DBFactory::RegisterDB("gsm_db", []() -> DB * { return new gsm_db(); });
+bool gsm_db_registered = DBFactory::RegisterDB<gsm_db>("gsm_db");
 
-bool gsm_diom_db_registered = DBFactory::RegisterDB(
-    "gsm_diom_db", []() -> DB * { return new gsm_diom_db(); });
+bool gsm_diom_db_registered = DBFactory::RegisterDB<gsm_diom_db>("gsm_diom_db");
 
-bool gsm_ii_db_registered = DBFactory::RegisterDB(
-    "gsm_ii_db", []() -> DB * { return new gsm_ii_db(); });
+bool gsm_ii_db_registered = DBFactory::RegisterDB<gsm_ii_db>("gsm_ii_db");
 
-bool gsm_diom_ii_db_registered = DBFactory::RegisterDB(
-    "gsm_diom_ii_db", []() -> DB * { return new gsm_diom_ii_db(); });
+bool gsm_diom_ii_db_registered = DBFactory::RegisterDB<gsm_diom_ii_db>("gsm_diom_ii_db");
+
+bool null_db_registered = DBFactory::RegisterDB<NullDB>("null_db");
+
+bool striped_db_registered = DBFactory::RegisterDB<StripedDB>("striped_db");
 
 } // namespace
 
-std::map<std::string, DBFactory::DBCreator> &DBFactory::Registry() {
-  static std::map<std::string, DBCreator> registry;
+std::map<std::string, DBFactory::Entry> &DBFactory::Registry() {
+  static std::map<std::string, Entry> registry;
   return registry;
 }
 
 bool DBFactory::RegisterDB(std::string db_name, DBCreator db_creator) {
-  Registry()[db_name] = db_creator;
+  Registry()[db_name].db_creator = db_creator;
   return true;
 }
 
+const DBFactory::StaticBinding *DBFactory::FindStaticBinding(utils::Properties *props,
+                                                             Measurements *measurements) {
+  if (props->GetProperty("clientloop", "static") != "static") {
+    return nullptr;
+  }
+  std::map<std::string, Entry> &registry = Registry();
+  auto it = registry.find(props->GetProperty("dbname", "basic"));
+  if (it == registry.end()) {
+    return nullptr;
+  }
+  const StaticBinding *binding = nullptr;
+  if (dynamic_cast<BasicMeasurements *>(measurements)) {
+    binding = &it->second.basic;
+#ifdef HDRMEASUREMENT
+  } else if (dynamic_cast<HdrHistogramMeasurements *>(measurements)) {
+    binding = &it->second.hdrhistogram;
+#endif
+  }
+  if (binding == nullptr || binding->db_creator == nullptr) {
+    return nullptr;
+  }
+  return binding;
+}
+
 DB *DBFactory::CreateDB(utils::Properties *props, Measurements *measurements) {
+  const StaticBinding *binding = FindStaticBinding(props, measurements);
+  if (binding) {
+    return binding->db_creator(props, measurements);
+  }
   std::string db_name = props->GetProperty("dbname", "basic");
   DB *db = nullptr;
-  std::map<std::string, DBCreator> &registry = Registry();
+  std::map<std::string, Entry> &registry = Registry();
   if (registry.find(db_name) != registry.end()) {
-    DB *new_db = (*registry[db_name])();
+    DB *new_db = (*registry[db_name].db_creator)();
     new_db->SetProps(props);
     db = new DBWrapper(new_db, measurements);
   }
   return db;
 }
 
+ClientThreadFunc DBFactory::GetClientThread(utils::Properties *props, Measurements *measurements) {
+  const StaticBinding *binding = FindStaticBinding(props, measurements);
+  if (binding) {
+    return binding->client_thread;
+  }
+  return ClientThread;
+}
+
 } // namespace ycsbc
@@ -9,7 +9,9 @@
 #ifndef YCSB_C_DB_FACTORY_H_
 #define YCSB_C_DB_FACTORY_H_
 
+#include "client.h"
 #include "db.h"
+#include "db_wrapper.h"
 #include "measurements.h"
 #include "utils/properties.h"
 
@@ -22,11 +24,62 @@ class DBFactory {
  public:
   using DBCreator = DB *(*)();
   static bool RegisterDB(std::string db_name, DBCreator db_creator);
+  ///
+  /// Registers a DB class along with, for each measurement type, a client
+  /// loop in which calls into the DB and the measurements bind statically.
+  ///
+  template <typename DBImpl>
+  static bool RegisterDB(std::string db_name);
   static DB *CreateDB(utils::Properties *props, Measurements *measurements);
+  ///
+  /// Returns the client loop to drive DBs returned by CreateDB with the same
+  /// properties and measurements.
+  ///
+  static ClientThreadFunc GetClientThread(utils::Properties *props, Measurements *measurements);
  private:
-  static std::map<std::string, DBCreator> &Registry();
+  using StaticDBCreator = DB *(*)(utils::Properties *props, Measurements *measurements);
+  struct StaticBinding {
+    StaticDBCreator db_creator = nullptr;
+    ClientThreadFunc client_thread = nullptr;
+  };
+  struct Entry {
+    DBCreator db_creator = nullptr;
+    StaticBinding basic;
+#ifdef HDRMEASUREMENT
+    StaticBinding hdrhistogram;
+#endif
+  };
+  template <typename DBImpl, typename MeasurementsImpl>
+  static StaticBinding MakeStaticBinding();
+  static const StaticBinding *FindStaticBinding(utils::Properties *props,
+                                                Measurements *measurements);
+  static std::map<std::string, Entry> &Registry();
 };
 
+template <typename DBImpl>
+bool DBFactory::RegisterDB(std::string db_name) {
+  Entry &entry = Registry()[db_name];
+  entry.db_creator = []() -> DB * { return new DBImpl(); };
+  entry.basic = MakeStaticBinding<DBImpl, BasicMeasurements>();
+#ifdef HDRMEASUREMENT
+  entry.hdrhistogram = MakeStaticBinding<DBImpl, HdrHistogramMeasurements>();
+#endif
+  return true;
+}
+
+template <typename DBImpl, typename MeasurementsImpl>
+DBFactory::StaticBinding DBFactory::MakeStaticBinding() {
+  using Wrapper = TypedDBWrapper<DBImpl, MeasurementsImpl>;
+  StaticBinding binding;
+  binding.db_creator = [](utils::Properties *props, Measurements *measurements) -> DB * {
+    DBImpl *db = new DBImpl();
+    db->SetProps(props);
+    return new Wrapper(db, static_cast<MeasurementsImpl *>(measurements));
+  };
+  binding.client_thread = TypedClientThread<Wrapper>;
+  return binding;
+}
+
 } // ycsbc
 
 #endif // YCSB_C_DB_FACTORY_H_
@@ -8,6 +8,8 @@
 #ifndef YCSB_C_DB_WRAPPER_H_
 #define YCSB_C_DB_WRAPPER_H_
 
+#include <functional>
+#include <span>
 #include <string>
 #include <vector>
 
@@ -18,10 +20,15 @@
 
 namespace ycsbc {
 
-class DBWrapper : public DB {
+///
+/// Times every call into the wrapped DB and reports it to the measurements.
+/// With final DBImpl and MeasurementsImpl classes, those calls bind statically.
+///
+template <typename DBImpl = DB, typename MeasurementsImpl = Measurements>
+class TypedDBWrapper final : public DB {
  public:
-  DBWrapper(DB *db, Measurements *measurements) : db_(db), measurements_(measurements) {}
-  ~DBWrapper() {
+  TypedDBWrapper(DBImpl *db, MeasurementsImpl *measurements) : db_(db), measurements_(measurements) {}
+  ~TypedDBWrapper() {
     delete db_;
   }
   void Init() {
@@ -30,6 +37,9 @@ class DBWrapper : public DB {
   void Cleanup() {
     db_->Cleanup();
   }
+  void Prefetch(const std::string &table, const std::string &key) {
+    db_->Prefetch(table, key);
+  }
   Status Read(const std::string &table, const std::string &key,
               const std::vector<std::string> *fields, std::vector<Field> &result) {
     timer_.Start();
@@ -76,6 +86,83 @@ class DBWrapper : public DB {
     }
     return s;
   }
+  Status BulkInsert(const std::string &table, std::span<Record> records) {
+    if (records.empty()) {
+      return kOK;
+    }
+    timer_.Start();
+    Status s = db_->BulkInsert(table, records);
+    uint64_t elapsed = timer_.End();
+    // one sample per record, so insert counts match those of single inserts
+    for (size_t i = 0; i < records.size(); i++) {
+      measurements_->Report(s == kOK ? INSERT : INSERT_FAILED, elapsed / records.size());
+    }
+    return s;
+  }
+  Status MultiRead(const std::string &table, std::span<const std::string> keys,
+                   const std::vector<std::string> *fields,
+                   std::vector<std::vector<Field>> &results) {
+    timer_.Start();
+    Status s = db_->MultiRead(table, keys, fields, results);
+    uint64_t elapsed = timer_.End();
+    // one sample per batch; the client counts the keys
+    if (s == kOK) {
+      measurements_->Report(MULTIREAD, elapsed);
+    } else {
+      measurements_->Report(MULTIREAD_FAILED, elapsed);
+    }
+    return s;
+  }
+  Status MultiUpdate(const std::string &table, std::span<const std::string> keys,
+                     std::span<std::vector<Field>> values) {
+    timer_.Start();
+    Status s = db_->MultiUpdate(table, keys, values);
+    uint64_t elapsed = timer_.End();
+    if (s == kOK) {
+      measurements_->Report(MULTIUPDATE, elapsed);
+    } else {
+      measurements_->Report(MULTIUPDATE_FAILED, elapsed);
+    }
+    return s;
+  }
+  Status ReadModifyWrite(const std::string &table, const std::string &key,
+                         const std::vector<std::string> *fields,
+                         const std::function<void(std::vector<Field> &)> &modify) {
+    timer_.Start();
+    Status s = db_->ReadModifyWrite(table, key, fields, modify);
+    uint64_t elapsed = timer_.End();
+    if (s == kOK) {
+      measurements_->Report(READMODIFYWRITE, elapsed);
+    } else {
+      measurements_->Report(READMODIFYWRITE_FAILED, elapsed);
+    }
+    return s;
+  }
+  Status InsertIfAbsent(const std::string &table, const std::string &key,
+                        std::vector<Field> &values) {
+    timer_.Start();
+    Status s = db_->InsertIfAbsent(table, key, values);
+    uint64_t elapsed = timer_.End();
+    if (s == kOK) {
+      measurements_->Report(INSERT, elapsed);
+    } else {
+      measurements_->Report(INSERT_FAILED, elapsed);
+    }
+    return s;
+  }
+  Status CompareAndSwap(const std::string &table, const std::string &key,
+                        std::vector<Field> &expected, std::vector<Field> &values) {
+    timer_.Start();
+    Status s = db_->CompareAndSwap(table, key, expected, values);
+    uint64_t elapsed = timer_.End();
+    // the swap half of a read-modify-write, so it is not mixed in with plain updates
+    if (s == kOK) {
+      measurements_->Report(READMODIFYWRITE, elapsed);
+    } else {
+      measurements_->Report(READMODIFYWRITE_FAILED, elapsed);
+    }
+    return s;
+  }
   Status Delete(const std::string &table, const std::string &key) {
     timer_.Start();
     Status s = db_->Delete(table, key);
@@ -88,11 +175,13 @@ class DBWrapper : public DB {
     return s;
   }
  private:
-  DB *db_;
-  Measurements *measurements_;
+  DBImpl *db_;
+  MeasurementsImpl *measurements_;
   utils::Timer<uint64_t, std::nano> timer_;
 };
 
+using DBWrapper = TypedDBWrapper<>;
+
 } // ycsbc
 
 #endif // YCSB_C_DB_WRAPPER_H_
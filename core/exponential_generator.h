@@ -0,0 +1,40 @@
+//
+//  exponential_generator.h
+//  YCSB-cpp
+//
+
+#ifndef YCSB_C_EXPONENTIAL_GENERATOR_H_
+#define YCSB_C_EXPONENTIAL_GENERATOR_H_
+
+#include "generator.h"
+
+#include <random>
+
+namespace ycsbc {
+
+class ExponentialGenerator : public Generator<uint64_t> {
+ public:
+  ExponentialGenerator(double mean) : generator_(std::random_device{}()), dist_(1.0 / mean) {
+    Next();
+  }
+
+  uint64_t Next();
+  uint64_t Last();
+
+ private:
+  std::mt19937_64 generator_;
+  std::exponential_distribution<double> dist_;
+  uint64_t last_int_;
+};
+
+inline uint64_t ExponentialGenerator::Next() {
+  return last_int_ = dist_(generator_);
+}
+
+inline uint64_t ExponentialGenerator::Last() {
+  return last_int_;
+}
+
+} // ycsbc
+
+#endif // YCSB_C_EXPONENTIAL_GENERATOR_H_
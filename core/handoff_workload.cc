@@ -0,0 +1,76 @@
+//
+//  handoff_workload.cc
+//  YCSB-cpp
+//
+
+#include "handoff_workload.h"
+
+#include <chrono>
+#include <cstring>
+#include <thread>
+
+namespace ycsbc {
+
+namespace {
+
+uint64_t NowNanos() {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+      std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+} // namespace
+
+void HandoffWorkload::Init(const utils::Properties &p) {
+  CoreWorkload::Init(p);
+  item_count_ = std::stoull(p.GetProperty(OPERATION_COUNT_PROPERTY));
+}
+
+bool HandoffWorkload::Produce(DB &db, ThreadState &state) {
+  const uint64_t item = produced_.fetch_add(1, std::memory_order_relaxed);
+  if (item >= item_count_) {
+    return false;
+  }
+  BuildKeyName(record_count_ + item, state.key);
+  BuildValues(state.values);
+  std::string &value = state.values[0].value;
+  if (value.size() < sizeof(uint64_t)) {
+    value.resize(sizeof(uint64_t));
+  }
+  const uint64_t now = NowNanos();
+  std::memcpy(value.data(), &now, sizeof(now));
+  if (db.Insert(table_name_, state.key, state.values) != DB::kOK) {
+    failed_inserts_.fetch_add(1, std::memory_order_relaxed);
+  }
+  return true;
+}
+
+HandoffWorkload::ConsumeStatus HandoffWorkload::Consume(DB &db, ThreadState &state,
+                                                        utils::ThreadControl *control,
+                                                        uint64_t *latency, uint64_t *misses) {
+  const uint64_t item = consumed_.fetch_add(1, std::memory_order_relaxed);
+  if (item >= item_count_) {
+    return kDone;
+  }
+  BuildKeyName(record_count_ + item, state.key);
+  // poll until the item is there; once no producer is left, one more read decides
+  while (true) {
+    const bool last_chance = producers_running_.load() == 0;
+    state.values.clear();
+    if (db.Read(table_name_, state.key, nullptr, state.values) == DB::kOK &&
+        !state.values.empty() && state.values[0].value.size() >= sizeof(uint64_t)) {
+      break;
+    }
+    (*misses)++;
+    if (last_chance || (control && !control->Continue())) {
+      return kLost;
+    }
+    std::this_thread::yield();
+  }
+  uint64_t produced;
+  std::memcpy(&produced, state.values[0].value.data(), sizeof(produced));
+  *latency = NowNanos() - produced;
+  db.Delete(table_name_, state.key);
+  return kTaken;
+}
+
+} // ycsbc
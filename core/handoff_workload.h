@@ -0,0 +1,73 @@
+//
+//  handoff_workload.h
+//  YCSB-cpp
+//
+//  Producers hand items to consumers through the table: one inserts, another
+//  reads and deletes.
+//
+
+#ifndef YCSB_C_HANDOFF_WORKLOAD_H_
+#define YCSB_C_HANDOFF_WORKLOAD_H_
+
+#include <atomic>
+#include <cstdint>
+
+#include "core_workload.h"
+#include "db.h"
+#include "utils/properties.h"
+#include "utils/thread_control.h"
+
+namespace ycsbc {
+
+///
+/// A CoreWorkload whose transactions are handoffs of operationcount items,
+/// keyed after the loaded records. The first field of an item holds the
+/// time it was produced.
+///
+class HandoffWorkload : public CoreWorkload {
+ public:
+  enum ConsumeStatus {
+    kTaken, // the item was read and deleted
+    kLost,  // every producer finished, or the run was stopped, before the item appeared
+    kDone   // no items are left to take
+  };
+
+  void Init(const utils::Properties &p) override;
+
+  ///
+  /// Sets how many producers Produce items. Each calls ProducerFinished once
+  /// it stops, so consumers know when an item will never appear.
+  ///
+  void SetProducerCount(int count) { producers_running_.store(count); }
+  void ProducerFinished() { producers_running_.fetch_sub(1); }
+
+  ///
+  /// Inserts the next item. An item whose insert fails is counted in
+  /// failed_inserts() and left for its consumer to find lost. Returns
+  /// false, doing nothing, once all items have been produced.
+  ///
+  bool Produce(DB &db, ThreadState &state);
+
+  ///
+  /// Takes the next item in production order, reads it until it is there,
+  /// counting each read that missed in misses, and deletes it. Sets latency
+  /// to the nanoseconds from its insert to the read that found it. Polling
+  /// gives up, with kLost, once all producers have finished or control is
+  /// stopped.
+  ///
+  ConsumeStatus Consume(DB &db, ThreadState &state, utils::ThreadControl *control,
+                        uint64_t *latency, uint64_t *misses);
+
+  uint64_t failed_inserts() const { return failed_inserts_.load(); }
+
+ private:
+  uint64_t item_count_ = 0;
+  std::atomic<uint64_t> produced_{0};
+  std::atomic<uint64_t> consumed_{0};
+  std::atomic<uint64_t> failed_inserts_{0};
+  std::atomic<int> producers_running_{0};
+};
+
+} // ycsbc
+
+#endif // YCSB_C_HANDOFF_WORKLOAD_H_
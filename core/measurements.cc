@@ -8,6 +8,7 @@
 #include "measurements.h"
 #include "utils/utils.h"
 
+#include <chrono>
 #include <limits>
 #include <numeric>
 #include <sstream>
@@ -62,6 +63,18 @@ std::string BasicMeasurements::GetStatusMsg() {
   return std::to_string(total_cnt) + msg_stream.str();
 }
 
+uint64_t BasicMeasurements::GetTotalCount() {
+  uint64_t total_cnt = 0;
+  for (int op = 0; op < MAXOPTYPE; op++) {
+    total_cnt += count_[op].load(std::memory_order_relaxed);
+  }
+  return total_cnt;
+}
+
+bool BasicMeasurements::GetPercentile(double, uint64_t *) {
+  return false;
+}
+
 void BasicMeasurements::Reset() {
   std::fill(std::begin(count_), std::end(count_), 0);
   std::fill(std::begin(latency_sum_), std::end(latency_sum_), 0);
@@ -78,6 +91,12 @@ HdrHistogramMeasurements::HdrHistogramMeasurements() {
   }
 }
 
+HdrHistogramMeasurements::~HdrHistogramMeasurements() {
+  for (int op = 0; op < MAXOPTYPE; op++) {
+    hdr_close(histogram_[op]);
+  }
+}
+
 void HdrHistogramMeasurements::Report(Operation op, uint64_t latency) {
   hdr_record_value_atomic(histogram_[op], latency);
 }
@@ -107,6 +126,27 @@ std::string HdrHistogramMeasurements::GetStatusMsg() {
   return std::to_string(total_cnt) + msg_stream.str();
 }
 
+uint64_t HdrHistogramMeasurements::GetTotalCount() {
+  uint64_t total_cnt = 0;
+  for (int op = 0; op < MAXOPTYPE; op++) {
+    total_cnt += histogram_[op]->total_count;
+  }
+  return total_cnt;
+}
+
+bool HdrHistogramMeasurements::GetPercentile(double percentile, uint64_t *latency) {
+  hdr_histogram *all;
+  if (hdr_init(10, 100LL * 1000 * 1000 * 1000, 3, &all) != 0) {
+    return false;
+  }
+  for (int op = 0; op < MAXOPTYPE; op++) {
+    hdr_add(all, histogram_[op]);
+  }
+  *latency = hdr_value_at_percentile(all, percentile);
+  hdr_close(all);
+  return true;
+}
+
 void HdrHistogramMeasurements::Reset() {
   for (int op = 0; op < MAXOPTYPE; op++) {
     hdr_reset(histogram_[op]);
@@ -114,6 +154,87 @@ void HdrHistogramMeasurements::Reset() {
 }
 #endif
 
+TimelineMeasurements::TimelineMeasurements(Measurements *base, uint64_t interval,
+                                           uint64_t stall_threshold, uint64_t records)
+    : base_(base), interval_(interval), stall_threshold_(stall_threshold), records_(records),
+      stall_count_(0), start_(Now()), slots_(new Slot[kMaxIntervals]()) {
+}
+
+TimelineMeasurements::~TimelineMeasurements() {
+  delete base_;
+}
+
+uint64_t TimelineMeasurements::Now() const {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+      std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+void TimelineMeasurements::Report(Operation op, uint64_t latency) {
+  base_->Report(op, latency);
+  if (op == DELETE) {
+    records_.fetch_sub(1, std::memory_order_relaxed);
+    return;
+  }
+  if (op != INSERT) {
+    return;
+  }
+  uint64_t records = records_.fetch_add(1, std::memory_order_relaxed) + 1;
+  uint64_t time = Now() - start_;
+  Slot &slot = slots_[std::min(time / interval_, kMaxIntervals - 1)];
+  slot.inserts.fetch_add(1, std::memory_order_relaxed);
+  slot.latency_sum.fetch_add(latency, std::memory_order_relaxed);
+  uint64_t prev_max = slot.latency_max.load(std::memory_order_relaxed);
+  while (prev_max < latency
+         && !slot.latency_max.compare_exchange_weak(prev_max, latency, std::memory_order_relaxed));
+  uint64_t prev_records = slot.records.load(std::memory_order_relaxed);
+  while (prev_records < records
+         && !slot.records.compare_exchange_weak(prev_records, records, std::memory_order_relaxed));
+
+  if (latency >= stall_threshold_) {
+    stall_count_.fetch_add(1, std::memory_order_relaxed);
+    std::lock_guard<std::mutex> lock(stall_mutex_);
+    if (stalls_.size() < kMaxStalls) {
+      stalls_.push_back({time, latency, records});
+    }
+  }
+}
+
+void TimelineMeasurements::Reset() {
+  base_->Reset();
+  for (uint64_t i = 0; i < kMaxIntervals; i++) {
+    slots_[i].inserts = 0;
+    slots_[i].latency_sum = 0;
+    slots_[i].latency_max = 0;
+    slots_[i].records = 0;
+  }
+  std::lock_guard<std::mutex> lock(stall_mutex_);
+  stalls_.clear();
+  stall_count_ = 0;
+  start_ = Now();
+}
+
+std::vector<TimelineMeasurements::Interval> TimelineMeasurements::GetTimeline() {
+  uint64_t end = kMaxIntervals;
+  while (end > 0 && slots_[end - 1].inserts.load(std::memory_order_relaxed) == 0) {
+    end--;
+  }
+  std::vector<Interval> timeline(end);
+  for (uint64_t i = 0; i < end; i++) {
+    Interval &interval = timeline[i];
+    interval.inserts = slots_[i].inserts.load(std::memory_order_relaxed);
+    interval.mean_latency = interval.inserts > 0
+        ? slots_[i].latency_sum.load(std::memory_order_relaxed) / interval.inserts : 0;
+    interval.max_latency = slots_[i].latency_max.load(std::memory_order_relaxed);
+    interval.records = slots_[i].records.load(std::memory_order_relaxed);
+  }
+  return timeline;
+}
+
+std::vector<TimelineMeasurements::Stall> TimelineMeasurements::GetStalls() {
+  std::lock_guard<std::mutex> lock(stall_mutex_);
+  return stalls_;
+}
+
 Measurements *CreateMeasurements(utils::Properties *props) {
   std::string name = props->GetProperty(MEASUREMENT_TYPE, MEASUREMENT_TYPE_DEFAULT);
 
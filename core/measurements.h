@@ -12,6 +12,9 @@
 #include "utils/properties.h"
 
 #include <atomic>
+#include <memory>
+#include <mutex>
+#include <vector>
 
 #ifdef HDRMEASUREMENT
 #include <hdr/hdr_histogram.h>
@@ -25,34 +28,150 @@ class Measurements {
  public:
   virtual void Report(Operation op, uint64_t latency) = 0;
   virtual std::string GetStatusMsg() = 0;
+  virtual uint64_t GetTotalCount() = 0;
+  // latency at the given percentile over all operations, false if not tracked
+  virtual bool GetPercentile(double percentile, uint64_t *latency) = 0;
   virtual void Reset() = 0;
+  virtual ~Measurements() { }
 };
 
-class BasicMeasurements : public Measurements {
+class BasicMeasurements final : public Measurements {
  public:
   BasicMeasurements();
   void Report(Operation op, uint64_t latency) override;
   std::string GetStatusMsg() override;
+  uint64_t GetTotalCount() override;
+  bool GetPercentile(double percentile, uint64_t *latency) override;
   void Reset() override;
  private:
-  std::atomic<uint> count_[MAXOPTYPE];
+  std::atomic<uint64_t> count_[MAXOPTYPE];
   std::atomic<uint64_t> latency_sum_[MAXOPTYPE];
   std::atomic<uint64_t> latency_min_[MAXOPTYPE];
   std::atomic<uint64_t> latency_max_[MAXOPTYPE];
 };
 
 #ifdef HDRMEASUREMENT
-class HdrHistogramMeasurements : public Measurements {
+class HdrHistogramMeasurements final : public Measurements {
  public:
   HdrHistogramMeasurements();
+  ~HdrHistogramMeasurements();
   void Report(Operation op, uint64_t latency) override;
   std::string GetStatusMsg() override;
+  uint64_t GetTotalCount() override;
+  bool GetPercentile(double percentile, uint64_t *latency) override;
   void Reset() override;
  private:
   hdr_histogram *histogram_[MAXOPTYPE];
 };
 #endif
 
+///
+/// Passes every report on to base, which it owns, and also records insert
+/// latency over time: the count, mean and maximum of each interval, and
+/// every insert that took at least stall_threshold, with the number of
+/// records right after it. Inserts add to the records count, starting from
+/// records, and deletes subtract from it. Times and latencies are in
+/// nanoseconds; times count from construction or the last Reset.
+///
+class TimelineMeasurements final : public Measurements {
+ public:
+  struct Interval {
+    uint64_t inserts;
+    uint64_t mean_latency;
+    uint64_t max_latency;
+    uint64_t records; // most records seen in the interval
+  };
+  struct Stall {
+    uint64_t time;
+    uint64_t latency;
+    uint64_t records;
+  };
+
+  TimelineMeasurements(Measurements *base, uint64_t interval, uint64_t stall_threshold,
+                       uint64_t records);
+  ~TimelineMeasurements();
+  void Report(Operation op, uint64_t latency) override;
+  std::string GetStatusMsg() override { return base_->GetStatusMsg(); }
+  uint64_t GetTotalCount() override { return base_->GetTotalCount(); }
+  bool GetPercentile(double percentile, uint64_t *latency) override {
+    return base_->GetPercentile(percentile, latency);
+  }
+  ///
+  /// Clears the timeline and the stalls, and restarts the clock. The records
+  /// count carries over.
+  ///
+  void Reset() override;
+
+  uint64_t interval() const { return interval_; }
+  ///
+  /// The intervals up to the last one with an insert.
+  ///
+  std::vector<Interval> GetTimeline();
+  std::vector<Stall> GetStalls();
+  ///
+  /// Number of stalls, including those beyond the ones GetStalls keeps.
+  ///
+  uint64_t GetStallCount() { return stall_count_.load(std::memory_order_relaxed); }
+
+ private:
+  // inserts after the last interval count towards it
+  static constexpr uint64_t kMaxIntervals = 1 << 16;
+  static constexpr size_t kMaxStalls = 1 << 16;
+
+  struct Slot {
+    std::atomic<uint64_t> inserts;
+    std::atomic<uint64_t> latency_sum;
+    std::atomic<uint64_t> latency_max;
+    std::atomic<uint64_t> records;
+  };
+
+  uint64_t Now() const;
+
+  Measurements *base_;
+  const uint64_t interval_;
+  const uint64_t stall_threshold_;
+  std::atomic<uint64_t> records_;
+  std::atomic<uint64_t> stall_count_;
+  uint64_t start_;
+  std::unique_ptr<Slot[]> slots_;
+  std::mutex stall_mutex_;
+  std::vector<Stall> stalls_;
+};
+
+///
+/// Passes every report on to base and to interval, both of which it owns.
+/// All else acts on base, except Reset, which resets both. The caller
+/// resets interval() to start each interval.
+///
+class IntervalMeasurements final : public Measurements {
+ public:
+  IntervalMeasurements(Measurements *base, Measurements *interval)
+      : base_(base), interval_(interval) {}
+  ~IntervalMeasurements() {
+    delete base_;
+    delete interval_;
+  }
+  void Report(Operation op, uint64_t latency) override {
+    base_->Report(op, latency);
+    interval_->Report(op, latency);
+  }
+  std::string GetStatusMsg() override { return base_->GetStatusMsg(); }
+  uint64_t GetTotalCount() override { return base_->GetTotalCount(); }
+  bool GetPercentile(double percentile, uint64_t *latency) override {
+    return base_->GetPercentile(percentile, latency);
+  }
+  void Reset() override {
+    base_->Reset();
+    interval_->Reset();
+  }
+
+  Measurements *interval() const { return interval_; }
+
+ private:
+  Measurements *base_;
+  Measurements *interval_;
+};
+
 Measurements *CreateMeasurements(utils::Properties *props);
 
 } // ycsbc
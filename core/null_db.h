@@ -0,0 +1,73 @@
+//
+//  null_db.h
+//  YCSB-cpp
+//
+//  A DB that does nothing, for measuring the overhead of the client itself.
+//
+
+#ifndef YCSB_C_NULL_DB_H_
+#define YCSB_C_NULL_DB_H_
+
+#include "db.h"
+
+#include <functional>
+#include <span>
+#include <string>
+#include <vector>
+
+namespace ycsbc {
+
+class NullDB final : public DB {
+ public:
+  Status Read(const std::string &, const std::string &, const std::vector<std::string> *,
+              std::vector<Field> &) {
+    return kOK;
+  }
+
+  Status Scan(const std::string &, const std::string &, int,
+              const std::vector<std::string> *, std::vector<std::vector<Field>> &) {
+    return kOK;
+  }
+
+  Status Update(const std::string &, const std::string &, std::vector<Field> &) {
+    return kOK;
+  }
+
+  Status Insert(const std::string &, const std::string &, std::vector<Field> &) {
+    return kOK;
+  }
+
+  Status MultiRead(const std::string &, std::span<const std::string>,
+                   const std::vector<std::string> *,
+                   std::vector<std::vector<Field>> &) {
+    return kOK;
+  }
+
+  Status MultiUpdate(const std::string &, std::span<const std::string>,
+                     std::span<std::vector<Field>>) {
+    return kOK;
+  }
+
+  Status ReadModifyWrite(const std::string &, const std::string &,
+                         const std::vector<std::string> *,
+                         const std::function<void(std::vector<Field> &)> &) {
+    return kOK;
+  }
+
+  Status InsertIfAbsent(const std::string &, const std::string &, std::vector<Field> &) {
+    return kOK;
+  }
+
+  Status CompareAndSwap(const std::string &, const std::string &,
+                        std::vector<Field> &, std::vector<Field> &) {
+    return kOK;
+  }
+
+  Status Delete(const std::string &, const std::string &) {
+    return kOK;
+  }
+};
+
+} // ycsbc
+
+#endif // YCSB_C_NULL_DB_H_
@@ -0,0 +1,266 @@
+//
+//  striped_db.h
+//  YCSB-cpp
+//
+//  An in-memory hash table with a lock per stripe of buckets. Every call,
+//  compound ones included, finds its record once, under the lock of the
+//  record's stripe, so read-modify-write, insert-if-absent and
+//  compare-and-swap are atomic single lookups. Prefetch starts loading a
+//  key's bucket and lock, for coroutines; MultiRead and MultiUpdate hash a
+//  whole batch and start loading all its buckets before the first probe.
+//
+
+#ifndef YCSB_C_STRIPED_DB_H_
+#define YCSB_C_STRIPED_DB_H_
+
+#include "db.h"
+
+#include <algorithm>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <string>
+#include <vector>
+
+namespace ycsbc {
+
+class StripedDB final : public DB {
+ public:
+  StripedDB() : table_(SharedTable()) {}
+
+  Status Read(const std::string &, const std::string &key,
+              const std::vector<std::string> *fields, std::vector<Field> &result) {
+    const size_t bucket = BucketOf(key);
+    std::lock_guard<std::mutex> lock(StripeOf(bucket));
+    const Node *node = Find(bucket, key);
+    if (node == nullptr) {
+      return kNotFound;
+    }
+    CopyFields(node->values, fields, result);
+    return kOK;
+  }
+
+  Status Scan(const std::string &, const std::string &, int,
+              const std::vector<std::string> *, std::vector<std::vector<Field>> &) {
+    // buckets keep no key order
+    return kNotImplemented;
+  }
+
+  Status Update(const std::string &, const std::string &key, std::vector<Field> &values) {
+    const size_t bucket = BucketOf(key);
+    std::lock_guard<std::mutex> lock(StripeOf(bucket));
+    Node *node = Find(bucket, key);
+    if (node == nullptr) {
+      return kNotFound;
+    }
+    MergeFields(values, node->values);
+    return kOK;
+  }
+
+  Status Insert(const std::string &, const std::string &key, std::vector<Field> &values) {
+    const size_t bucket = BucketOf(key);
+    std::lock_guard<std::mutex> lock(StripeOf(bucket));
+    Node *node = Find(bucket, key);
+    if (node == nullptr) {
+      Add(bucket, key, values);
+    } else {
+      node->values = values;
+    }
+    return kOK;
+  }
+
+  Status MultiRead(const std::string &, std::span<const std::string> keys,
+                   const std::vector<std::string> *fields,
+                   std::vector<std::vector<Field>> &results) {
+    HashBatch(keys);
+    Status result = kOK;
+    for (size_t i = 0; i < keys.size(); i++) {
+      results.emplace_back();
+      std::lock_guard<std::mutex> lock(StripeOf(batch_buckets_[i]));
+      const Node *node = Find(batch_buckets_[i], keys[i]);
+      if (node == nullptr) {
+        result = result == kOK ? kNotFound : result;
+        continue;
+      }
+      CopyFields(node->values, fields, results.back());
+    }
+    return result;
+  }
+
+  Status MultiUpdate(const std::string &, std::span<const std::string> keys,
+                     std::span<std::vector<Field>> values) {
+    HashBatch(keys);
+    Status result = kOK;
+    for (size_t i = 0; i < keys.size(); i++) {
+      std::lock_guard<std::mutex> lock(StripeOf(batch_buckets_[i]));
+      Node *node = Find(batch_buckets_[i], keys[i]);
+      if (node == nullptr) {
+        result = result == kOK ? kNotFound : result;
+        continue;
+      }
+      MergeFields(values[i], node->values);
+    }
+    return result;
+  }
+
+  Status ReadModifyWrite(const std::string &, const std::string &key,
+                         const std::vector<std::string> *fields,
+                         const std::function<void(std::vector<Field> &)> &modify) {
+    const size_t bucket = BucketOf(key);
+    std::lock_guard<std::mutex> lock(StripeOf(bucket));
+    Node *node = Find(bucket, key);
+    if (node == nullptr) {
+      return kNotFound;
+    }
+    std::vector<Field> values;
+    CopyFields(node->values, fields, values);
+    modify(values);
+    MergeFields(values, node->values);
+    return kOK;
+  }
+
+  Status InsertIfAbsent(const std::string &, const std::string &key, std::vector<Field> &values) {
+    const size_t bucket = BucketOf(key);
+    std::lock_guard<std::mutex> lock(StripeOf(bucket));
+    if (Find(bucket, key) != nullptr) {
+      return kConflict;
+    }
+    Add(bucket, key, values);
+    return kOK;
+  }
+
+  Status CompareAndSwap(const std::string &, const std::string &key,
+                        std::vector<Field> &expected, std::vector<Field> &values) {
+    const size_t bucket = BucketOf(key);
+    std::lock_guard<std::mutex> lock(StripeOf(bucket));
+    Node *node = Find(bucket, key);
+    if (node == nullptr) {
+      return kNotFound;
+    }
+    if (!std::equal(node->values.begin(), node->values.end(), expected.begin(), expected.end(),
+                    [](const Field &a, const Field &b) {
+                      return a.name == b.name && a.value == b.value;
+                    })) {
+      expected = node->values;
+      return kConflict;
+    }
+    MergeFields(values, node->values);
+    return kOK;
+  }
+
+  void Prefetch(const std::string &, const std::string &key) {
+    // the bucket slot and its stripe's lock are the first two misses of a
+    // lookup; the chain itself can only be read under the lock
+    const size_t bucket = BucketOf(key);
+    __builtin_prefetch(&table_.buckets[bucket]);
+    __builtin_prefetch(&StripeOf(bucket), 1);
+  }
+
+  Status Delete(const std::string &, const std::string &key) {
+    const size_t bucket = BucketOf(key);
+    std::lock_guard<std::mutex> lock(StripeOf(bucket));
+    for (std::unique_ptr<Node> *link = &table_.buckets[bucket]; *link; link = &(*link)->next) {
+      if ((*link)->key == key) {
+        *link = std::move((*link)->next);
+        return kOK;
+      }
+    }
+    return kNotFound;
+  }
+
+ private:
+  static constexpr size_t kBucketCount = 1 << 20;
+  static constexpr size_t kStripeCount = 1 << 12;
+
+  struct Node {
+    std::string key;
+    std::vector<Field> values;
+    std::unique_ptr<Node> next;
+  };
+  // one cache line per lock, so stripes do not share lines
+  struct alignas(64) Stripe {
+    std::mutex mutex;
+  };
+  struct Table {
+    Table() : buckets(kBucketCount), stripes(kStripeCount) {}
+    std::vector<std::unique_ptr<Node>> buckets;
+    std::vector<Stripe> stripes;
+  };
+
+  // every client thread's instance works on the same table
+  static Table &SharedTable() {
+    static Table table;
+    return table;
+  }
+
+  static size_t BucketOf(const std::string &key) {
+    return std::hash<std::string>{}(key) & (kBucketCount - 1);
+  }
+
+  std::mutex &StripeOf(size_t bucket) {
+    return table_.stripes[bucket & (kStripeCount - 1)].mutex;
+  }
+
+  // hashes every key of a batch and starts loading all their buckets and
+  // locks, so the misses overlap instead of coming one probe at a time
+  void HashBatch(std::span<const std::string> keys) {
+    batch_buckets_.resize(keys.size());
+    for (size_t i = 0; i < keys.size(); i++) {
+      batch_buckets_[i] = BucketOf(keys[i]);
+      __builtin_prefetch(&table_.buckets[batch_buckets_[i]]);
+      __builtin_prefetch(&StripeOf(batch_buckets_[i]), 1);
+    }
+  }
+
+  Node *Find(size_t bucket, const std::string &key) {
+    for (Node *node = table_.buckets[bucket].get(); node != nullptr; node = node->next.get()) {
+      if (node->key == key) {
+        return node;
+      }
+    }
+    return nullptr;
+  }
+
+  void Add(size_t bucket, const std::string &key, const std::vector<Field> &values) {
+    std::unique_ptr<Node> node(new Node{key, values, std::move(table_.buckets[bucket])});
+    table_.buckets[bucket] = std::move(node);
+  }
+
+  // appends the fields named in fields, or all of them, to result
+  static void CopyFields(const std::vector<Field> &record, const std::vector<std::string> *fields,
+                         std::vector<Field> &result) {
+    if (fields == nullptr) {
+      result.insert(result.end(), record.begin(), record.end());
+      return;
+    }
+    for (const auto &name : *fields) {
+      for (const auto &field : record) {
+        if (field.name == name) {
+          result.push_back(field);
+          break;
+        }
+      }
+    }
+  }
+
+  // overwrites the record's fields named in values, adding those it lacks
+  static void MergeFields(const std::vector<Field> &values, std::vector<Field> &record) {
+    for (const auto &value : values) {
+      auto it = std::find_if(record.begin(), record.end(),
+                             [&value](const Field &field) { return field.name == value.name; });
+      if (it == record.end()) {
+        record.push_back(value);
+      } else {
+        it->value = value.value;
+      }
+    }
+  }
+
+  Table &table_;
+  std::vector<size_t> batch_buckets_; // bucket of each key of the current batch
+};
+
+} // ycsbc
+
+#endif // YCSB_C_STRIPED_DB_H_
@@ -0,0 +1,80 @@
+//
+//  tee_db.h
+//  YCSB-cpp
+//
+//  Sends writes to two DBs and reads to the first, so that two engines are
+//  loaded with the same records. Owns neither DB.
+//
+
+#ifndef YCSB_C_TEE_DB_H_
+#define YCSB_C_TEE_DB_H_
+
+#include "db.h"
+
+#include <span>
+#include <string>
+#include <vector>
+
+namespace ycsbc {
+
+class TeeDB final : public DB {
+ public:
+  TeeDB(DB *first, DB *second) : first_(first), second_(second) {}
+
+  void Init() {
+    first_->Init();
+    second_->Init();
+  }
+
+  void Cleanup() {
+    first_->Cleanup();
+    second_->Cleanup();
+  }
+
+  Status Read(const std::string &table, const std::string &key,
+              const std::vector<std::string> *fields, std::vector<Field> &result) {
+    return first_->Read(table, key, fields, result);
+  }
+
+  Status Scan(const std::string &table, const std::string &key, int len,
+              const std::vector<std::string> *fields, std::vector<std::vector<Field>> &result) {
+    return first_->Scan(table, key, len, fields, result);
+  }
+
+  Status Update(const std::string &table, const std::string &key, std::vector<Field> &values) {
+    Status s = first_->Update(table, key, values);
+    second_->Update(table, key, values);
+    return s;
+  }
+
+  Status Insert(const std::string &table, const std::string &key, std::vector<Field> &values) {
+    Status s = first_->Insert(table, key, values);
+    second_->Insert(table, key, values);
+    return s;
+  }
+
+  Status BulkInsert(const std::string &table, std::span<Record> records) {
+    Status s = first_->BulkInsert(table, records);
+    second_->BulkInsert(table, records);
+    return s;
+  }
+
+  Status Delete(const std::string &table, const std::string &key) {
+    Status s = first_->Delete(table, key);
+    second_->Delete(table, key);
+    return s;
+  }
+
+  void Prefetch(const std::string &table, const std::string &key) {
+    first_->Prefetch(table, key);
+    second_->Prefetch(table, key);
+  }
+
+ private:
+  DB *first_;
+  DB *second_;
+};
+
+} // ycsbc
+
+#endif // YCSB_C_TEE_DB_H_
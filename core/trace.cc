@@ -0,0 +1,91 @@
+//
+//  trace.cc
+//  YCSB-cpp
+//
+
+#include "trace.h"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "core_workload.h"
+#include "utils/utils.h"
+
+namespace ycsbc {
+
+namespace {
+
+const char kTraceMagic[8] = {'Y', 'C', 'S', 'B', 'T', 'R', 'C', '1'};
+
+} // namespace
+
+Trace::Trace(const std::string &path) {
+  int fd = open(path.c_str(), O_RDONLY);
+  if (fd < 0) {
+    throw utils::Exception("failed to open: " + path);
+  }
+  struct stat st;
+  if (fstat(fd, &st) != 0 || static_cast<size_t>(st.st_size) < sizeof(TraceHeader)) {
+    close(fd);
+    throw utils::Exception("not a trace file: " + path);
+  }
+  bytes_ = st.st_size;
+  data_ = mmap(nullptr, bytes_, PROT_READ, MAP_PRIVATE | MAP_POPULATE, fd, 0);
+  close(fd);
+  if (data_ == MAP_FAILED) {
+    throw utils::Exception("failed to map: " + path);
+  }
+  const TraceHeader *header = static_cast<const TraceHeader *>(data_);
+  size_ = header->entry_count;
+  if (std::memcmp(header->magic, kTraceMagic, sizeof(kTraceMagic)) != 0 ||
+      sizeof(TraceHeader) + size_ * sizeof(TraceEntry) > bytes_) {
+    munmap(data_, bytes_);
+    throw utils::Exception("not a trace file: " + path);
+  }
+  entries_ = reinterpret_cast<const TraceEntry *>(header + 1);
+  for (uint64_t i = 0; i < size_; i++) {
+    if (!IsTransactionOperation(entries_[i].op)) {
+      const std::string message = "invalid operation " + std::to_string(entries_[i].op) +
+                                  " at entry " + std::to_string(i) + " of trace: " + path;
+      munmap(data_, bytes_);
+      throw utils::Exception(message);
+    }
+  }
+}
+
+Trace::~Trace() {
+  munmap(data_, bytes_);
+}
+
+TraceRecorder::TraceRecorder(const std::string &path, uint64_t capacity)
+    : path_(path), start_(std::chrono::steady_clock::now()), entries_(capacity), next_(0) {
+}
+
+void TraceRecorder::Write() {
+  entries_.resize(std::min<uint64_t>(next_.load(), entries_.size()));
+  // clients record concurrently, so slots are only roughly in time order
+  std::stable_sort(entries_.begin(), entries_.end(),
+                   [](const TraceEntry &a, const TraceEntry &b) {
+                     return a.timestamp < b.timestamp;
+                   });
+
+  std::ofstream out(path_, std::ios::binary | std::ios::trunc);
+  TraceHeader header{};
+  std::memcpy(header.magic, kTraceMagic, sizeof(kTraceMagic));
+  header.entry_count = entries_.size();
+  out.write(reinterpret_cast<const char *>(&header), sizeof(header));
+  out.write(reinterpret_cast<const char *>(entries_.data()),
+            entries_.size() * sizeof(TraceEntry));
+  out.close();
+  if (out.fail()) {
+    throw utils::Exception("failed to write trace: " + path_);
+  }
+}
+
+} // ycsbc
@@ -0,0 +1,93 @@
+//
+//  trace.h
+//  YCSB-cpp
+//
+//  Timestamped operation traces, replayed by TraceWorkload and recorded
+//  from any run of CoreWorkload.
+//
+
+#ifndef YCSB_C_TRACE_H_
+#define YCSB_C_TRACE_H_
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace ycsbc {
+
+///
+/// A trace file is a TraceHeader followed by entry_count TraceEntry, in host
+/// byte order and in timestamp order.
+///
+struct TraceHeader {
+  char magic[8];
+  uint64_t entry_count;
+};
+
+///
+/// One operation: when it was issued, in nanoseconds from any fixed point,
+/// its Operation code, the number of its key, in 0 to recordcount - 1 for
+/// the key to exist after loading, and the bytes written per field, 0 to
+/// draw them from the field length distribution.
+///
+struct TraceEntry {
+  uint64_t timestamp;
+  uint64_t key_num;
+  uint32_t op;
+  uint32_t value_size;
+};
+
+///
+/// A trace file mapped read-only into memory.
+///
+class Trace {
+ public:
+  explicit Trace(const std::string &path);
+  ~Trace();
+  Trace(const Trace &) = delete;
+  Trace &operator=(const Trace &) = delete;
+
+  uint64_t size() const { return size_; }
+  const TraceEntry &entry(uint64_t index) const { return entries_[index]; }
+
+ private:
+  void *data_;
+  size_t bytes_;
+  const TraceEntry *entries_;
+  uint64_t size_;
+};
+
+///
+/// Collects up to capacity operations from any number of threads and writes
+/// them to a trace file.
+///
+class TraceRecorder {
+ public:
+  TraceRecorder(const std::string &path, uint64_t capacity);
+
+  void Record(int op, uint64_t key_num, uint32_t value_size) {
+    uint64_t index = next_.fetch_add(1, std::memory_order_relaxed);
+    if (index < entries_.size()) {
+      uint64_t timestamp = std::chrono::duration_cast<std::chrono::nanoseconds>(
+          std::chrono::steady_clock::now() - start_).count();
+      entries_[index] = {timestamp, key_num, static_cast<uint32_t>(op), value_size};
+    }
+  }
+
+  ///
+  /// Writes the recorded operations. Not safe to call concurrently with Record.
+  ///
+  void Write();
+
+ private:
+  const std::string path_;
+  const std::chrono::steady_clock::time_point start_;
+  std::vector<TraceEntry> entries_;
+  std::atomic<uint64_t> next_;
+};
+
+} // ycsbc
+
+#endif // YCSB_C_TRACE_H_
@@ -0,0 +1,122 @@
+//
+//  trace_workload.cc
+//  YCSB-cpp
+//
+
+#include "trace_workload.h"
+
+#include <chrono>
+#include <thread>
+
+#include "utils/utils.h"
+
+namespace ycsbc {
+
+const std::string TraceWorkload::TRACE_FILE_PROPERTY = "trace.file";
+
+const std::string TraceWorkload::TRACE_PARTITIONING_PROPERTY = "trace.partitioning";
+const std::string TraceWorkload::TRACE_PARTITIONING_DEFAULT = "roundrobin";
+
+const std::string TraceWorkload::TRACE_TIMESTAMPS_PROPERTY = "trace.timestamps";
+const std::string TraceWorkload::TRACE_TIMESTAMPS_DEFAULT = "false";
+
+const std::string TraceWorkload::TRACE_SPEEDUP_PROPERTY = "trace.speedup";
+const std::string TraceWorkload::TRACE_SPEEDUP_DEFAULT = "1";
+
+bool TraceWorkload::Selected(const utils::Properties &p) {
+  return p.GetProperty("workload", "").ends_with("TraceWorkload");
+}
+
+void TraceWorkload::Init(const utils::Properties &p) {
+  CoreWorkload::Init(p);
+  if (!p.ContainsKey(TRACE_FILE_PROPERTY)) {
+    throw utils::Exception("TraceWorkload needs " + TRACE_FILE_PROPERTY);
+  }
+  trace_ = std::make_unique<Trace>(p.GetProperty(TRACE_FILE_PROPERTY));
+  if (trace_->size() == 0) {
+    throw utils::Exception("Trace is empty");
+  }
+  replay_ops_ = true;
+
+  std::string partitioning = p.GetProperty(TRACE_PARTITIONING_PROPERTY,
+                                           TRACE_PARTITIONING_DEFAULT);
+  if (partitioning == "hash") {
+    hash_partitioning_ = true;
+  } else if (partitioning != "roundrobin") {
+    throw utils::Exception("Unknown trace partitioning: " + partitioning);
+  }
+  timestamps_ = utils::StrToBool(p.GetProperty(TRACE_TIMESTAMPS_PROPERTY,
+                                               TRACE_TIMESTAMPS_DEFAULT));
+  speedup_ = std::stod(p.GetProperty(TRACE_SPEEDUP_PROPERTY, TRACE_SPEEDUP_DEFAULT));
+  if (speedup_ <= 0) {
+    throw utils::Exception("trace.speedup must be positive");
+  }
+  lap_duration_ = trace_->entry(trace_->size() - 1).timestamp - trace_->entry(0).timestamp + 1;
+}
+
+ThreadState TraceWorkload::InitThread(int thread_id, int thread_count) {
+  ThreadState state = CoreWorkload::InitThread(thread_id, thread_count);
+  state.op_begin = thread_id;
+  while (state.op_begin < trace_->size() && !Owns(state, state.op_begin)) {
+    state.op_begin++;
+  }
+  if (state.op_begin >= trace_->size()) {
+    throw utils::Exception("Trace has no entries for client " + std::to_string(thread_id));
+  }
+  state.op_next = state.op_begin;
+  state.op_end = trace_->size();
+  return state;
+}
+
+bool TraceWorkload::Owns(const ThreadState &state, uint64_t index) const {
+  if (hash_partitioning_) {
+    return utils::Hash(trace_->entry(index).key_num) % state.thread_count ==
+           static_cast<uint64_t>(state.thread_id);
+  }
+  return index % state.thread_count == static_cast<uint64_t>(state.thread_id);
+}
+
+uint64_t TraceWorkload::NextEntry(ThreadState &state) {
+  uint64_t index = state.op_next;
+  // InitThread made sure the share is not empty, so this finds the next entry
+  do {
+    state.op_next += hash_partitioning_ ? 1 : state.thread_count;
+    if (state.op_next >= state.op_end) {
+      state.op_next = state.op_begin;
+      state.op_lap++;
+    }
+  } while (hash_partitioning_ && !Owns(state, state.op_next));
+  return index;
+}
+
+void TraceWorkload::WaitUntilDue(uint64_t lap, const TraceEntry &entry) {
+  using Clock = std::chrono::steady_clock;
+  int64_t now = std::chrono::duration_cast<std::chrono::nanoseconds>(
+      Clock::now().time_since_epoch()).count();
+  // the first entry any client replays starts the replay clock
+  int64_t start = 0;
+  if (start_.compare_exchange_strong(start, now)) {
+    start = now;
+  }
+  // each time a client starts its share over, its entries fall one trace later
+  uint64_t offset = entry.timestamp - trace_->entry(0).timestamp + lap * lap_duration_;
+  int64_t due = start + static_cast<int64_t>(offset / speedup_);
+  if (due > now) {
+    std::this_thread::sleep_for(std::chrono::nanoseconds(due - now));
+  }
+}
+
+void TraceWorkload::ChooseTransaction(ThreadState &state, PendingTransaction &txn) {
+  const uint64_t lap = state.op_lap;
+  const TraceEntry &entry = trace_->entry(NextEntry(state));
+  if (timestamps_) {
+    WaitUntilDue(lap, entry);
+  }
+  txn.workload = this;
+  txn.op = static_cast<Operation>(entry.op);
+  txn.key_num = entry.key_num;
+  txn.value_size = entry.value_size;
+  BuildKeyName(txn.key_num, txn.key);
+}
+
+} // ycsbc
@@ -0,0 +1,81 @@
+//
+//  trace_workload.h
+//  YCSB-cpp
+//
+//  Replays a recorded operation trace in place of the synthetic operation mix.
+//
+
+#ifndef YCSB_C_TRACE_WORKLOAD_H_
+#define YCSB_C_TRACE_WORKLOAD_H_
+
+#include <atomic>
+#include <memory>
+#include <string>
+
+#include "core_workload.h"
+#include "trace.h"
+#include "utils/properties.h"
+
+namespace ycsbc {
+
+///
+/// A CoreWorkload whose transactions are the entries of a trace file. The
+/// load phase, record layout and key format are those of CoreWorkload.
+/// Each client replays its share of the trace, from the start again once
+/// its share is used up.
+///
+class TraceWorkload : public CoreWorkload {
+ public:
+  ///
+  /// The name of the property for the trace file to replay.
+  ///
+  static const std::string TRACE_FILE_PROPERTY;
+
+  ///
+  /// The name of the property for how entries are shared among clients:
+  /// "roundrobin" (entry i goes to client i % threadcount) or "hash" (all
+  /// entries of a key go to the same client, keeping their order).
+  ///
+  static const std::string TRACE_PARTITIONING_PROPERTY;
+  static const std::string TRACE_PARTITIONING_DEFAULT;
+
+  ///
+  /// The name of the property for deciding whether to issue each entry at
+  /// its timestamp, relative to the first one (true), or as fast as
+  /// possible (false).
+  ///
+  static const std::string TRACE_TIMESTAMPS_PROPERTY;
+  static const std::string TRACE_TIMESTAMPS_DEFAULT;
+
+  ///
+  /// The name of the property for the factor by which timestamped replay
+  /// runs faster than the trace was recorded.
+  ///
+  static const std::string TRACE_SPEEDUP_PROPERTY;
+  static const std::string TRACE_SPEEDUP_DEFAULT;
+
+  ///
+  /// Whether the workload property names TraceWorkload.
+  ///
+  static bool Selected(const utils::Properties &p);
+
+  void Init(const utils::Properties &p) override;
+  ThreadState InitThread(int thread_id, int thread_count) override;
+  void ChooseTransaction(ThreadState &state, PendingTransaction &txn) override;
+
+ private:
+  uint64_t NextEntry(ThreadState &state);
+  bool Owns(const ThreadState &state, uint64_t index) const;
+  void WaitUntilDue(uint64_t lap, const TraceEntry &entry);
+
+  std::unique_ptr<Trace> trace_;
+  bool hash_partitioning_ = false;
+  bool timestamps_ = false;
+  double speedup_ = 1;
+  uint64_t lap_duration_ = 0; // nanoseconds from the first entry to one past the last
+  std::atomic<int64_t> start_{0}; // steady clock nanoseconds of the first replayed entry
+};
+
+} // ycsbc
+
+#endif // YCSB_C_TRACE_WORKLOAD_H_
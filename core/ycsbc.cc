@@ -6,9 +6,19 @@
 //  Copyright (c) 2014 Jinglei Ren <jinglei@ren.systems>.
 //
 
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
 #include <cstring>
 #include <ctime>
+#include <fstream>
 
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <barrier>
+#include <cmath>
 #include <string>
 #include <iostream>
 #include <vector>
@@ -16,21 +26,93 @@
 #include <future>
 #include <chrono>
 #include <iomanip>
+#include <limits>
+#include <map>
+#include <memory>
+#include <numeric>
+#include <sstream>
+#include <utility>
 
 #include "client.h"
+#include "const_generator.h"
 #include "core_workload.h"
 #include "db_factory.h"
+#include "exponential_generator.h"
+#include "handoff_workload.h"
 #include "measurements.h"
+#include "tee_db.h"
+#include "trace_workload.h"
+#include "uniform_generator.h"
+#include "utils/cache_flush.h"
 #include "utils/countdown_latch.h"
+#include "utils/interference.h"
 #include "utils/rate_limit.h"
+#include "utils/sysinfo.h"
+#include "utils/thread_control.h"
 #include "utils/timer.h"
 #include "utils/utils.h"
 
 void UsageMessage(const char *command);
 bool StrStartWith(const char *str, const char *pre);
-void ParseCommandLine(int argc, const char *argv[], ycsbc::utils::Properties &props);
+void ParseCommandLine(int argc, const char *argv[], ycsbc::utils::Properties &props,
+                      ycsbc::utils::Properties &command_line);
+
+// A named set of client threads running its own workload against the shared table
+struct ThreadGroup {
+  std::string name;
+  int num_threads;
+  ycsbc::utils::Properties props;
+  ycsbc::CoreWorkload *wl;
+  ycsbc::Measurements *measurements;
+  std::vector<ycsbc::DB *> dbs;
+  int64_t ops;
+  double runtime;
+};
+
+std::vector<ThreadGroup> ParseThreadGroups(const ycsbc::utils::Properties &props,
+                                          const ycsbc::utils::Properties &command_line);
+void RunThreadGroups(std::vector<ThreadGroup> &groups, bool show_status, int status_interval);
+
+// One step of a phase schedule: how long it lasts and the properties it runs with
+struct Phase {
+  int64_t duration;
+  int num_threads;
+  std::string settings;
+  ycsbc::utils::Properties props;
+};
+
+std::vector<Phase> ParsePhaseFile(const std::string &phase_file,
+                                  const ycsbc::utils::Properties &props);
+
+ycsbc::Generator<uint64_t> *CreateThinkTimeGenerator(const ycsbc::utils::Properties &props);
+
+bool ForkRun(const std::string &prefix);
+bool ForkSweepRuns(ycsbc::utils::Properties &props);
+bool ForkSizeSweepRuns(ycsbc::utils::Properties &props);
+
+void RunCompare(const std::vector<ycsbc::DB *> &a_dbs, const std::vector<ycsbc::DB *> &b_dbs,
+                ycsbc::Measurements *a_measurements, ycsbc::Measurements *b_measurements,
+                ycsbc::CoreWorkload &wl, const ycsbc::utils::Properties &props, bool init_db);
+
+void RunSloSearch(const std::vector<ycsbc::DB *> &dbs, ycsbc::ClientThreadFunc client_thread,
+                  ycsbc::Measurements *measurements, ycsbc::CoreWorkload &wl,
+                  const ycsbc::utils::Properties &props, bool init_db);
+void RunInterferenceLevels(const std::vector<ycsbc::DB *> &dbs,
+                           ycsbc::ClientThreadFunc client_thread,
+                           ycsbc::Measurements *measurements, ycsbc::CoreWorkload &wl,
+                           const ycsbc::utils::Properties &props, bool init_db);
+
+void PrintTimeline(const std::string &phase, ycsbc::TimelineMeasurements *timeline,
+                   std::ofstream *timeline_file);
+void RunGrowth(const std::vector<ycsbc::DB *> &dbs, ycsbc::ClientThreadFunc client_thread,
+               ycsbc::TimelineMeasurements *timeline, ycsbc::CoreWorkload &wl,
+               ycsbc::utils::Properties &props, bool init_db, std::ofstream *timeline_file);
+void RunHandoff(const std::vector<ycsbc::DB *> &dbs, ycsbc::Measurements *measurements,
+                ycsbc::HandoffWorkload &wl, ycsbc::utils::Properties &props, bool init_db);
 
-void StatusThread(ycsbc::Measurements *measurements, ycsbc::utils::CountDownLatch *latch, int interval) {
+using StatusSources = std::vector<std::pair<std::string, ycsbc::Measurements *>>;
+
+void StatusThread(StatusSources sources, ycsbc::utils::CountDownLatch *latch, int interval) {
   using namespace std::chrono;
   time_point<system_clock> start = system_clock::now();
   bool done = false;
@@ -39,10 +121,14 @@ void StatusThread(ycsbc::Measurements *measurements, ycsbc::utils::CountDownLatc
     std::time_t now_c = system_clock::to_time_t(now);
     duration<double> elapsed_time = now - start;
 
-    std::cout << std::put_time(std::localtime(&now_c), "%F %T") << ' '
-              << static_cast<long long>(elapsed_time.count()) << " sec: ";
-
-    std::cout << measurements->GetStatusMsg() << std::endl;
+    for (auto &source : sources) {
+      std::cout << std::put_time(std::localtime(&now_c), "%F %T") << ' '
+                << static_cast<long long>(elapsed_time.count()) << " sec: ";
+      if (!source.first.empty()) {
+        std::cout << '[' << source.first << "] ";
+      }
+      std::cout << source.second->GetStatusMsg() << std::endl;
+    }
 
     if (done) {
       break;
@@ -51,6 +137,40 @@ void StatusThread(ycsbc::Measurements *measurements, ycsbc::utils::CountDownLatc
   };
 }
 
+// Prints the throughput and p99 latency of every interval seconds, and the
+// resident memory at its end, until the clients are done
+void SampleThread(ycsbc::IntervalMeasurements *measurements, ycsbc::utils::CountDownLatch *latch,
+                  int interval) {
+  ycsbc::Measurements *window = measurements->interval();
+  window->Reset();
+  const uint64_t first_resident = ycsbc::utils::GetResidentBytes();
+  uint64_t resident = first_resident;
+  ycsbc::utils::Timer<double> timer;
+  timer.Start();
+  double last_time = 0;
+  bool done = false;
+  for (int sample = 1; !done; sample++) {
+    done = latch->AwaitFor(interval);
+    const double time = timer.End();
+    const uint64_t ops = window->GetTotalCount();
+    uint64_t p99;
+    const bool has_p99 = window->GetPercentile(99, &p99);
+    window->Reset();
+    resident = ycsbc::utils::GetResidentBytes();
+
+    const std::string prefix = "Sample " + std::to_string(sample) + " ";
+    std::cout << prefix << "time(sec): " << time << std::endl;
+    std::cout << prefix << "throughput(ops/sec): " << ops / (time - last_time) << std::endl;
+    if (has_p99) {
+      std::cout << prefix << "p99 latency(us): " << p99 / 1000.0 << std::endl;
+    }
+    std::cout << prefix << "resident(bytes): " << resident << std::endl;
+    last_time = time;
+  }
+  std::cout << "Resident growth(bytes): " << static_cast<int64_t>(resident - first_resident)
+            << std::endl;
+}
+
 void RateLimitThread(std::string rate_file, std::vector<ycsbc::utils::RateLimiter *> rate_limiters,
                      ycsbc::utils::CountDownLatch *latch) {
   std::ifstream ifs;
@@ -84,9 +204,80 @@ void RateLimitThread(std::string rate_file, std::vector<ycsbc::utils::RateLimite
   }
 }
 
+// Runs the first num_active client threads and parks the others
+void SetActiveThreads(std::vector<ycsbc::utils::ThreadControl> &controls, int num_active) {
+  for (int i = 0; i < static_cast<int>(controls.size()); i++) {
+    if (i < num_active) {
+      controls[i].Resume();
+    } else {
+      controls[i].Park();
+    }
+  }
+}
+
+void PhaseThread(std::vector<Phase> phases, ycsbc::CoreWorkload *wl,
+                 std::vector<ycsbc::utils::RateLimiter *> rate_limiters,
+                 ycsbc::Measurements *measurements,
+                 std::vector<ycsbc::utils::ThreadControl> *controls,
+                 ycsbc::utils::CountDownLatch *latch) {
+  for (size_t i = 0; i < phases.size(); i++) {
+    // the first phase is applied before the clients start
+    if (i > 0) {
+      wl->Reconfigure(phases[i].props);
+      SetActiveThreads(*controls, phases[i].num_threads);
+    }
+    int64_t ops_limit = std::stoll(phases[i].props.GetProperty("limit.ops", "0"));
+    for (auto x : rate_limiters) {
+      x->SetRate(ops_limit / phases[i].num_threads);
+    }
+
+    ycsbc::utils::Timer<double> timer;
+    timer.Start();
+    bool done = latch->AwaitFor(phases[i].duration);
+    double runtime = timer.End();
+
+    uint64_t ops = measurements->GetTotalCount();
+    std::cout << "Phase " << i + 1 << " settings: " << phases[i].settings << std::endl;
+    std::cout << "Phase " << i + 1 << " runtime(sec): " << runtime << std::endl;
+    std::cout << "Phase " << i + 1 << " operations(ops): " << ops << std::endl;
+    std::cout << "Phase " << i + 1 << " throughput(ops/sec): " << ops / runtime << std::endl;
+    std::cout << "Phase " << i + 1 << " latency: " << measurements->GetStatusMsg() << std::endl;
+    measurements->Reset();
+
+    if (done) {
+      break;
+    }
+  }
+  for (auto &control : *controls) {
+    control.Stop();
+  }
+}
+
 int main(const int argc, const char *argv[]) {
   ycsbc::utils::Properties props;
-  ParseCommandLine(argc, argv, props);
+  ycsbc::utils::Properties command_line; // the properties set by options other than -P
+  ParseCommandLine(argc, argv, props, command_line);
+
+  // dataset tool: writes the records, and operations, a later run loads from
+  // dataset.file, instead of running anything
+  if (props.ContainsKey("dataset.write")) {
+    if (props.ContainsKey(ycsbc::CoreWorkload::DATASET_FILE_PROPERTY)) {
+      std::cerr << "dataset.write and dataset.file cannot be used together" << std::endl;
+      exit(1);
+    }
+    const uint64_t op_count = std::stoull(props.GetProperty("dataset.ops", "0"));
+    try {
+      ycsbc::CoreWorkload wl;
+      wl.Init(props);
+      wl.WriteDataset(props.GetProperty("dataset.write"), op_count);
+    } catch (const ycsbc::utils::Exception &e) {
+      std::cerr << "Caught exception: " << e.what() << std::endl;
+      exit(1);
+    }
+    std::cout << "Dataset records: " << props.GetProperty("recordcount") << std::endl;
+    std::cout << "Dataset operations: " << op_count << std::endl;
+    return 0;
+  }
 
   const bool do_load = (props.GetProperty("doload", "false") == "true");
   const bool do_transaction = (props.GetProperty("dotransaction", "false") == "true");
@@ -95,13 +286,162 @@ int main(const int argc, const char *argv[]) {
     exit(1);
   }
 
+  // working-set size sweep: each record count loads and runs in its own child
+  const bool size_sweep = (props.GetProperty("sizesweep", "false") == "true");
+  if (size_sweep) {
+    if (!do_load) {
+      std::cerr << "sizesweep needs the load phase" << std::endl;
+      exit(1);
+    }
+    if (!ForkSizeSweepRuns(props)) {
+      return 0;
+    }
+  }
+
   const int num_threads = stoi(props.GetProperty("threadcount", "1"));
+  // the load phase may use more or fewer clients than the transaction phase
+  const int load_threads = stoi(props.GetProperty("loadthreads", std::to_string(num_threads)));
+  if (load_threads < 1) {
+    std::cerr << "loadthreads must be at least 1" << std::endl;
+    exit(1);
+  }
+  // the transaction phase keeps the DBs, already initialized, of a load phase
+  // with as many clients
+  const bool keep_load_dbs = do_load && load_threads == num_threads;
+
+  // thread groups replace the threadcount clients of the transaction phase
+  std::vector<ThreadGroup> groups = ParseThreadGroups(props, command_line);
+  if (!groups.empty() && (props.ContainsKey("limit.file") || props.ContainsKey("phase.file") ||
+                          props.ContainsKey("clients"))) {
+    std::cerr << "limit.file, phase.file and clients cannot be used with thread groups"
+              << std::endl;
+    exit(1);
+  }
+  // hot-key contention sweep: hot set sizes and thread counts not swept
+  // explicitly get a default range
+  if (props.GetProperty("hotkey.sweep", "false") == "true") {
+    if (!props.ContainsKey("sweep.hotkey.count")) {
+      const uint64_t record_count = std::stoull(props.GetProperty(
+          ycsbc::CoreWorkload::RECORD_COUNT_PROPERTY));
+      std::string counts;
+      for (uint64_t count = 1; count <= std::min<uint64_t>(record_count, 10000); count *= 10) {
+        counts += (counts.empty() ? "" : ",") + std::to_string(count);
+      }
+      props.SetProperty("sweep.hotkey.count", counts);
+    }
+    if (!props.ContainsKey("sweep.threadcount")) {
+      const int max_threads = std::max<int>(num_threads, std::thread::hardware_concurrency());
+      std::string counts;
+      for (int count = 1; count <= max_threads; count *= 2) {
+        counts += (counts.empty() ? "" : ",") + std::to_string(count);
+      }
+      props.SetProperty("sweep.threadcount", counts);
+    }
+  }
+  const bool do_sweep = !props.GetPropertiesWithPrefix("sweep.").empty();
+  if (do_sweep && !groups.empty()) {
+    std::cerr << "sweep cannot be used with thread groups" << std::endl;
+    exit(1);
+  }
+  // compare mode: a second engine, loaded with the same records, that the
+  // transaction phase alternates with the first one
+  const std::string compare_dbname = props.GetProperty("compare.dbname", "");
+  if (!compare_dbname.empty() && (!groups.empty() || do_sweep || props.ContainsKey("limit.file") ||
+                                  props.ContainsKey("phase.file") ||
+                                  props.ContainsKey("clients") || load_threads != num_threads)) {
+    std::cerr << "compare cannot be used with thread groups, sweep, limit.file, phase.file, clients "
+                 "or loadthreads" << std::endl;
+    exit(1);
+  }
+  if (!compare_dbname.empty() && (std::stoi(props.GetProperty("compare.windows", "20")) < 2 ||
+                                  std::stoi(props.GetProperty("compare.windowops", "10000")) < 1)) {
+    std::cerr << "compare needs compare.windows of at least 2 and a positive compare.windowops"
+              << std::endl;
+    exit(1);
+  }
+  // SLO search: steps the target rate instead of running operationcount at limit.ops
+  const bool slo_search = props.ContainsKey("slo.latency");
+  // interference: runs operationcount once per interference level
+  const bool interference = props.ContainsKey("interference");
+  if ((slo_search || interference) &&
+      (!groups.empty() || !compare_dbname.empty() || props.ContainsKey("limit.file") ||
+       props.ContainsKey("phase.file") || props.ContainsKey("clients"))) {
+    std::cerr << "slo.latency and interference cannot be used with thread groups, compare, "
+                 "limit.file, phase.file or clients" << std::endl;
+    exit(1);
+  }
+  if (slo_search && interference) {
+    std::cerr << "slo.latency and interference cannot be used together" << std::endl;
+    exit(1);
+  }
+  // growth: inserts with concurrent readers, recording insert latency over time
+  const bool growth = (props.GetProperty("growth", "false") == "true");
+  if (growth && (!groups.empty() || !compare_dbname.empty() || slo_search || interference ||
+                 props.ContainsKey("limit.file") || props.ContainsKey("phase.file") ||
+                 props.ContainsKey("clients"))) {
+    std::cerr << "growth cannot be used with thread groups, compare, slo.latency, interference, "
+                 "limit.file, phase.file or clients" << std::endl;
+    exit(1);
+  }
+  if (growth && std::stoi(props.GetProperty("growth.readers", "0")) > 0 &&
+      std::stoll(props.GetProperty(ycsbc::CoreWorkload::RECORD_COUNT_PROPERTY, "0")) <= 0) {
+    // the readers' key chooser starts at record recordcount - 1
+    std::cerr << "growth.readers needs recordcount > 0" << std::endl;
+    exit(1);
+  }
+  // handoff: producers insert items that consumers read and delete
+  const bool handoff = (props.GetProperty("handoff", "false") == "true");
+  if (handoff && (growth || !groups.empty() || !compare_dbname.empty() || slo_search ||
+                  interference || props.ContainsKey("limit.file") ||
+                  props.ContainsKey("phase.file") || props.ContainsKey("clients"))) {
+    std::cerr << "handoff cannot be used with growth, thread groups, compare, slo.latency, "
+                 "interference, limit.file, phase.file or clients" << std::endl;
+    exit(1);
+  }
+  // trace replay: the transaction phase issues the entries of trace.file
+  const bool trace_workload = ycsbc::TraceWorkload::Selected(props);
+  if (trace_workload && handoff) {
+    std::cerr << "TraceWorkload cannot be used with handoff" << std::endl;
+    exit(1);
+  }
+  if (trace_workload && (!groups.empty() || do_sweep || props.ContainsKey("phase.file"))) {
+    std::cerr << "TraceWorkload cannot be used with thread groups, sweep or phase.file"
+              << std::endl;
+    exit(1);
+  }
 
   ycsbc::Measurements *measurements = ycsbc::CreateMeasurements(&props);
   if (measurements == nullptr) {
     std::cerr << "Unknown measurements name" << std::endl;
     exit(1);
   }
+  ycsbc::TimelineMeasurements *timeline = nullptr;
+  std::ofstream timeline_file;
+  if (growth) {
+    // a loaded table starts from empty, an unloaded one from recordcount records
+    const uint64_t records = do_load ? 0 : std::stoull(props.GetProperty(
+        ycsbc::CoreWorkload::RECORD_COUNT_PROPERTY, "0"));
+    timeline = new ycsbc::TimelineMeasurements(
+        measurements, std::stoull(props.GetProperty("growth.interval", "10")) * 1000 * 1000,
+        std::stoull(props.GetProperty("growth.stall", "1000")) * 1000, records);
+    measurements = timeline;
+    if (props.ContainsKey("growth.timeline")) {
+      timeline_file.open(props.GetProperty("growth.timeline"));
+      if (!timeline_file.is_open()) {
+        std::cerr << "failed to open: " << props.GetProperty("growth.timeline") << std::endl;
+        exit(1);
+      }
+      timeline_file << "phase,time(sec),records,inserts,mean latency(us),max latency(us)"
+                    << std::endl;
+    }
+  }
+  // samples of the transaction phase: throughput, tail latency and resident memory
+  const int sample_interval = std::stoi(props.GetProperty("rss.interval", "0"));
+  ycsbc::IntervalMeasurements *sampled = nullptr;
+  if (sample_interval > 0) {
+    sampled = new ycsbc::IntervalMeasurements(measurements, ycsbc::CreateMeasurements(&props));
+    measurements = sampled;
+  }
 
   std::vector<ycsbc::DB *> dbs;
   for (int i = 0; i < num_threads; i++) {
@@ -112,40 +452,77 @@ int main(const int argc, const char *argv[]) {
     }
     dbs.push_back(db);
   }
+  ycsbc::ClientThreadFunc client_thread = ycsbc::DBFactory::GetClientThread(&props, measurements);
+
+  ycsbc::utils::Properties compare_props = props;
+  ycsbc::Measurements *compare_measurements = nullptr;
+  std::vector<ycsbc::DB *> compare_dbs;
+  std::vector<ycsbc::DB *> load_dbs = dbs;
+  ycsbc::ClientThreadFunc load_client_thread = client_thread;
+  if (!compare_dbname.empty()) {
+    compare_props.SetProperty("dbname", compare_dbname);
+    compare_measurements = ycsbc::CreateMeasurements(&compare_props);
+    for (int i = 0; i < num_threads; i++) {
+      ycsbc::DB *db = ycsbc::DBFactory::CreateDB(&compare_props, compare_measurements);
+      if (db == nullptr) {
+        std::cerr << "Unknown database name " << compare_dbname << std::endl;
+        exit(1);
+      }
+      compare_dbs.push_back(db);
+      load_dbs[i] = new ycsbc::TeeDB(dbs[i], db);
+    }
+    load_client_thread = ycsbc::ClientThread;
+  } else if (do_load && !keep_load_dbs) {
+    load_dbs.clear();
+    for (int i = 0; i < load_threads; i++) {
+      load_dbs.push_back(ycsbc::DBFactory::CreateDB(&props, measurements));
+    }
+  }
 
-  ycsbc::CoreWorkload wl;
+  std::unique_ptr<ycsbc::CoreWorkload> workload;
+  if (trace_workload) {
+    workload = std::make_unique<ycsbc::TraceWorkload>();
+  } else if (handoff) {
+    workload = std::make_unique<ycsbc::HandoffWorkload>();
+  } else {
+    workload = std::make_unique<ycsbc::CoreWorkload>();
+  }
+  ycsbc::CoreWorkload &wl = *workload;
   wl.Init(props);
 
+  for (auto &group : groups) {
+    group.wl = new ycsbc::CoreWorkload;
+    group.wl->InitSharingKeySpace(group.props, wl);
+  }
+
   // print status periodically
   const bool show_status = (props.GetProperty("status", "false") == "true");
   const int status_interval = std::stoi(props.GetProperty("status.interval", "10"));
 
   // load phase
   if (do_load) {
-    const int total_ops = stoi(props[ycsbc::CoreWorkload::RECORD_COUNT_PROPERTY]);
+    const uint64_t resident_before_load = ycsbc::utils::GetResidentBytes();
 
-    ycsbc::utils::CountDownLatch latch(num_threads);
+    ycsbc::utils::CountDownLatch latch(load_threads);
     ycsbc::utils::Timer<double> timer;
 
     timer.Start();
     std::future<void> status_future;
     if (show_status) {
       status_future = std::async(std::launch::async, StatusThread,
-                                 measurements, &latch, status_interval);
+                                 StatusSources{{"", measurements}}, &latch, status_interval);
     }
-    std::vector<std::future<int>> client_threads;
-    for (int i = 0; i < num_threads; ++i) {
-      int thread_ops = total_ops / num_threads;
-      if (i < total_ops % num_threads) {
-        thread_ops++;
-      }
-
-      client_threads.emplace_back(std::async(std::launch::async, ycsbc::ClientThread, dbs[i], &wl,
-                                             thread_ops, true, true, !do_transaction, &latch, nullptr));
+    std::vector<std::future<int64_t>> client_threads;
+    for (int i = 0; i < load_threads; ++i) {
+      const int64_t thread_ops = wl.LoadCount(i, load_threads);
+      client_threads.emplace_back(std::async(std::launch::async, load_client_thread, load_dbs[i],
+                                             &wl, i, load_threads, thread_ops, true, true,
+                                             !do_transaction || !groups.empty() || !keep_load_dbs,
+                                             &latch, nullptr, nullptr, nullptr));
     }
-    assert((int)client_threads.size() == num_threads);
+    assert((int)client_threads.size() == load_threads);
 
-    int sum = 0;
+    int64_t sum = 0;
     for (auto &n : client_threads) {
       assert(n.valid());
       sum += n.get();
@@ -159,55 +536,228 @@ int main(const int argc, const char *argv[]) {
     std::cout << "Load runtime(sec): " << runtime << std::endl;
     std::cout << "Load operations(ops): " << sum << std::endl;
     std::cout << "Load throughput(ops/sec): " << sum / runtime << std::endl;
+    if (size_sweep) {
+      // resident memory can shrink during the load, when the allocator or the
+      // kernel gives back more than the table took; report no footprint then
+      const uint64_t resident_after_load = ycsbc::utils::GetResidentBytes();
+      const uint64_t footprint = resident_after_load > resident_before_load
+                                     ? resident_after_load - resident_before_load
+                                     : 0;
+      std::string fits_in = "DRAM";
+      for (auto &cache : ycsbc::utils::GetCacheSizes()) {
+        if (footprint <= cache.size) {
+          fits_in = cache.name;
+          break;
+        }
+      }
+      std::cout << "Load footprint(bytes): " << footprint << std::endl;
+      std::cout << "Load bytes per record: " << static_cast<double>(footprint) / sum << std::endl;
+      std::cout << "Load footprint fits in: " << fits_in << std::endl;
+    }
+    if (timeline) {
+      PrintTimeline("Load", timeline, timeline_file.is_open() ? &timeline_file : nullptr);
+    }
+
+    if (!keep_load_dbs && compare_dbname.empty()) {
+      for (auto db : load_dbs) {
+        delete db;
+      }
+    }
   }
 
   measurements->Reset();
+  if (compare_measurements) {
+    compare_measurements->Reset();
+  }
   std::this_thread::sleep_for(std::chrono::seconds(stoi(props.GetProperty("sleepafterload", "0"))));
 
+  // in a sweep, the transaction phase runs in forked children; the parent
+  // only relays their output
+  bool run_transactions = do_transaction;
+  if (do_transaction && do_sweep) {
+    run_transactions = ForkSweepRuns(props);
+    if (run_transactions) {
+      wl.Reconfigure(props);
+    }
+  }
 
   // transaction phase
-  if (do_transaction) {
+  if (run_transactions && !groups.empty()) {
+    RunThreadGroups(groups, show_status, status_interval);
+  } else if (run_transactions && !compare_dbname.empty()) {
+    RunCompare(dbs, compare_dbs, measurements, compare_measurements, wl, props, !keep_load_dbs);
+  } else if (run_transactions && slo_search) {
+    RunSloSearch(dbs, client_thread, measurements, wl, props, !keep_load_dbs);
+  } else if (run_transactions && interference) {
+    RunInterferenceLevels(dbs, client_thread, measurements, wl, props, !keep_load_dbs);
+  } else if (run_transactions && growth) {
+    RunGrowth(dbs, client_thread, timeline, wl, props, !keep_load_dbs,
+              timeline_file.is_open() ? &timeline_file : nullptr);
+  } else if (run_transactions && handoff) {
+    RunHandoff(dbs, measurements, static_cast<ycsbc::HandoffWorkload &>(wl), props,
+               !keep_load_dbs);
+  } else if (run_transactions) {
     // initial ops per second, unlimited if <= 0
-    const int64_t ops_limit = std::stoi(props.GetProperty("limit.ops", "0"));
+    const int64_t ops_limit = std::stoll(props.GetProperty("limit.ops", "0"));
     // rate file path for dynamic rate limiting, format "time_stamp_sec new_ops_per_second" per line
     std::string rate_file = props.GetProperty("limit.file", "");
+    // phase schedule path, format "duration_sec [property=value ...]" per line
+    std::string phase_file = props.GetProperty("phase.file", "");
 
-    const int total_ops = stoi(props[ycsbc::CoreWorkload::OPERATION_COUNT_PROPERTY]);
+    // with a phase schedule, the clients run until the schedule ends
+    std::vector<Phase> phases;
+    int64_t max_phase_ops_limit = 0;
+    if (phase_file != "") {
+      if (rate_file != "") {
+        std::cerr << "limit.file and phase.file cannot be used together" << std::endl;
+        exit(1);
+      }
+      phases = ParsePhaseFile(phase_file, props);
+      wl.Reconfigure(phases[0].props);
+      for (auto &phase : phases) {
+        max_phase_ops_limit = std::max<int64_t>(
+            max_phase_ops_limit, std::stoll(phase.props.GetProperty("limit.ops", "0")));
+      }
+    }
+    // a phase schedule may change how many client threads run, parking the rest
+    int run_threads = std::stoi(props.GetProperty("threadcount", "1"));
+    int min_phase_threads = run_threads;
+    for (auto &phase : phases) {
+      run_threads = std::max(run_threads, phase.num_threads);
+      min_phase_threads = std::min(min_phase_threads, phase.num_threads);
+    }
+    while (static_cast<int>(dbs.size()) < run_threads) {
+      dbs.push_back(ycsbc::DBFactory::CreateDB(&props, measurements));
+    }
+    std::vector<ycsbc::utils::ThreadControl> controls(run_threads);
+    if (!phases.empty()) {
+      SetActiveThreads(controls, phases[0].num_threads);
+    }
+
+    // virtual clients multiplexed onto the client threads, disabled if <= 0
+    const int num_clients = std::stoi(props.GetProperty("clients", "0"));
+    ycsbc::Measurements *client_measurements = nullptr;
+    std::vector<int64_t> client_ops;
+    std::vector<ycsbc::Generator<uint64_t> *> think_times;
+    if (num_clients > 0) {
+      if (num_clients < run_threads) {
+        std::cerr << "clients must be at least threadcount" << std::endl;
+        exit(1);
+      }
+      // a thread's clients share its hot set, so hot sets fit as they do without clients
+      wl.SetHotSetThreads(run_threads);
+      client_measurements = ycsbc::CreateMeasurements(&props);
+      client_ops.resize(num_clients);
+      for (int i = 0; i < run_threads; ++i) {
+        think_times.push_back(CreateThinkTimeGenerator(props));
+      }
+    }
 
-    ycsbc::utils::CountDownLatch latch(num_threads);
+    // cold-cache clients flush the caches every coldcache.interval transactions,
+    // disabled if <= 0
+    const int cold_interval = std::stoi(props.GetProperty("coldcache.interval", "0"));
+    const int cold_ops = std::stoi(props.GetProperty("coldcache.ops", "100"));
+    ycsbc::utils::CacheFlusher *flusher = nullptr;
+    std::barrier<ycsbc::ColdCacheFlush> *flush_barrier = nullptr;
+    ycsbc::Measurements *cold_measurements = nullptr;
+    ycsbc::Measurements *warm_measurements = nullptr;
+    if (cold_interval > 0) {
+      if (num_clients > 0) {
+        std::cerr << "coldcache cannot be used with clients" << std::endl;
+        exit(1);
+      }
+      if (!phases.empty()) {
+        // a parked thread would hold up the others at the next flush
+        std::cerr << "coldcache cannot be used with phase.file" << std::endl;
+        exit(1);
+      }
+      if (cold_ops <= 0 || cold_ops > cold_interval) {
+        std::cerr << "coldcache.ops must be positive and at most coldcache.interval" << std::endl;
+        exit(1);
+      }
+      std::vector<ycsbc::utils::CacheInfo> caches = ycsbc::utils::GetCacheSizes();
+      const uint64_t llc_size = caches.empty() ? 32 << 20 : caches.back().size;
+      const uint64_t flush_bytes = std::stoull(props.GetProperty("coldcache.flushsize",
+                                                                 std::to_string(2 * llc_size)));
+      const bool flush_tlb = props.GetProperty("coldcache.tlb", "false") == "true";
+      const uint64_t tlb_pages = std::stoull(props.GetProperty("coldcache.tlbpages", "16384"));
+      flusher = new ycsbc::utils::CacheFlusher(flush_bytes, flush_tlb ? tlb_pages : 0);
+      flush_barrier = new std::barrier<ycsbc::ColdCacheFlush>(run_threads,
+                                                              ycsbc::ColdCacheFlush{flusher});
+      cold_measurements = ycsbc::CreateMeasurements(&props);
+      warm_measurements = ycsbc::CreateMeasurements(&props);
+    }
+
+    const int64_t total_ops = phases.empty()
+        ? std::stoll(props[ycsbc::CoreWorkload::OPERATION_COUNT_PROPERTY])
+        : std::numeric_limits<int64_t>::max();
+
+    ycsbc::utils::CountDownLatch latch(run_threads);
     ycsbc::utils::Timer<double> timer;
 
     timer.Start();
     std::future<void> status_future;
     if (show_status) {
-      status_future = std::async(std::launch::async, StatusThread,
-                                 measurements, &latch, status_interval);
+      StatusSources sources{{"", measurements}};
+      if (client_measurements) {
+        sources.emplace_back("clients", client_measurements);
+      }
+      status_future = std::async(std::launch::async, StatusThread, sources, &latch,
+                                 status_interval);
+    }
+    std::future<void> sample_future;
+    if (sampled) {
+      sample_future = std::async(std::launch::async, SampleThread, sampled, &latch,
+                                 sample_interval);
     }
-    std::vector<std::future<int>> client_threads;
+    std::vector<std::future<int64_t>> client_threads;
     std::vector<ycsbc::utils::RateLimiter *> rate_limiters;
-    for (int i = 0; i < num_threads; ++i) {
-      int thread_ops = total_ops / num_threads;
-      if (i < total_ops % num_threads) {
+    for (int i = 0; i < run_threads; ++i) {
+      int64_t thread_ops = total_ops / run_threads;
+      if (i < total_ops % run_threads) {
         thread_ops++;
       }
       ycsbc::utils::RateLimiter *rlim = nullptr;
-      if (ops_limit > 0 || rate_file != "") {
-        int64_t per_thread_ops = ops_limit / num_threads;
-        rlim = new ycsbc::utils::RateLimiter(per_thread_ops, per_thread_ops);
+      if (ops_limit > 0 || rate_file != "" || !phases.empty()) {
+        int64_t per_thread_ops = ops_limit / run_threads;
+        // size the bucket for the fastest phase, so a rate change does not leave it too small
+        int64_t per_thread_burst = std::max(ops_limit, max_phase_ops_limit) / min_phase_threads;
+        rlim = new ycsbc::utils::RateLimiter(per_thread_ops, per_thread_burst);
       }
       rate_limiters.push_back(rlim);
-      client_threads.emplace_back(std::async(std::launch::async, ycsbc::ClientThread, dbs[i], &wl,
-                                             thread_ops, false, !do_load, true, &latch, rlim));
+      if (cold_interval > 0) {
+        client_threads.emplace_back(std::async(std::launch::async, ycsbc::ColdCacheClientThread,
+                                               dbs[i], &wl, i, run_threads, thread_ops,
+                                               !keep_load_dbs || i >= num_threads, true, &latch, rlim,
+                                               &controls[i], flush_barrier, cold_interval, cold_ops,
+                                               cold_measurements, warm_measurements));
+      } else if (num_clients > 0) {
+        client_threads.emplace_back(std::async(std::launch::async, ycsbc::VirtualClientThread,
+                                               dbs[i], &wl, i, run_threads, num_clients,
+                                               thread_ops, !keep_load_dbs || i >= num_threads, true,
+                                               think_times[i], &latch, rlim, &controls[i],
+                                               client_measurements, &client_ops));
+      } else {
+        client_threads.emplace_back(std::async(std::launch::async, client_thread, dbs[i], &wl,
+                                               i, run_threads, thread_ops, false,
+                                               !keep_load_dbs || i >= num_threads, true, &latch, rlim,
+                                               &controls[i], nullptr));
+      }
     }
 
     std::future<void> rlim_future;
     if (rate_file != "") {
       rlim_future = std::async(std::launch::async, RateLimitThread, rate_file, rate_limiters, &latch);
     }
+    std::future<void> phase_future;
+    if (!phases.empty()) {
+      phase_future = std::async(std::launch::async, PhaseThread, phases, &wl, rate_limiters,
+                                measurements, &controls, &latch);
+    }
 
-    assert((int)client_threads.size() == num_threads);
+    assert((int)client_threads.size() == run_threads);
 
-    int sum = 0;
+    int64_t sum = 0;
     for (auto &n : client_threads) {
       assert(n.valid());
       sum += n.get();
@@ -217,25 +767,1078 @@ int main(const int argc, const char *argv[]) {
     if (show_status) {
       status_future.wait();
     }
+    if (sampled) {
+      sample_future.wait();
+    }
 
     std::cout << "Run runtime(sec): " << runtime << std::endl;
     std::cout << "Run operations(ops): " << sum << std::endl;
     std::cout << "Run throughput(ops/sec): " << sum / runtime << std::endl;
+    uint64_t p99;
+    if ((size_sweep || do_sweep) && measurements->GetPercentile(99, &p99)) {
+      std::cout << "Run p99 latency(us): " << p99 / 1000.0 << std::endl;
+    }
+    if (cold_interval > 0) {
+      for (auto &state : {std::make_pair("Cold", cold_measurements),
+                          std::make_pair("Warm", warm_measurements)}) {
+        uint64_t latency;
+        if (state.second->GetPercentile(50, &latency)) {
+          std::cout << state.first << " p50 latency(us): " << latency / 1000.0 << std::endl;
+          state.second->GetPercentile(99, &latency);
+          std::cout << state.first << " p99 latency(us): " << latency / 1000.0 << std::endl;
+        }
+        std::cout << state.first << " latency: " << state.second->GetStatusMsg() << std::endl;
+      }
+      delete flush_barrier;
+      delete flusher;
+      delete cold_measurements;
+      delete warm_measurements;
+    }
+    if (num_clients > 0) {
+      auto minmax = std::minmax_element(client_ops.begin(), client_ops.end());
+      std::cout << "Clients min operations(ops): " << *minmax.first << std::endl;
+      std::cout << "Clients max operations(ops): " << *minmax.second << std::endl;
+      std::cout << "Clients latency: " << client_measurements->GetStatusMsg() << std::endl;
+      for (auto think_time : think_times) {
+        delete think_time;
+      }
+      delete client_measurements;
+    }
+  }
+
+  if (run_transactions && wl.trace_recorder()) {
+    try {
+      wl.trace_recorder()->Write();
+    } catch (const ycsbc::utils::Exception &e) {
+      std::cerr << "Caught exception: " << e.what() << std::endl;
+      exit(1);
+    }
+  }
+
+  for (auto db : dbs) {
+    delete db;
+  }
+  if (!compare_dbname.empty()) {
+    for (int i = 0; i < num_threads; i++) {
+      delete load_dbs[i];
+      delete compare_dbs[i];
+    }
+    delete compare_measurements;
+  }
+  for (auto &group : groups) {
+    for (auto db : group.dbs) {
+      delete db;
+    }
+    delete group.wl;
+    delete group.measurements;
+  }
+}
+
+std::vector<Phase> ParsePhaseFile(const std::string &phase_file,
+                                  const ycsbc::utils::Properties &props) {
+  std::ifstream ifs(phase_file);
+  if (!ifs.is_open()) {
+    std::cerr << "failed to open: " << phase_file << std::endl;
+    exit(1);
+  }
+
+  // each phase starts from the global properties, not from the previous phase
+  std::vector<Phase> phases;
+  std::string line;
+  while (std::getline(ifs, line)) {
+    line = ycsbc::utils::Trim(line);
+    if (line.empty() || line[0] == '#') {
+      continue;
+    }
+    std::istringstream tokens(line);
+    Phase phase;
+    phase.props = props;
+    if (!(tokens >> phase.duration) || phase.duration <= 0) {
+      std::cerr << "invalid phase duration: " << line << std::endl;
+      exit(1);
+    }
+    std::string setting;
+    while (tokens >> setting) {
+      size_t eq = setting.find('=');
+      if (eq == std::string::npos) {
+        std::cerr << "phase setting expected to be in key=value format: " << setting << std::endl;
+        exit(1);
+      }
+      phase.props.SetProperty(setting.substr(0, eq), setting.substr(eq + 1));
+      phase.settings += (phase.settings.empty() ? "" : " ") + setting;
+    }
+    phase.num_threads = std::stoi(phase.props.GetProperty("threadcount", "1"));
+    if (phase.num_threads < 1) {
+      std::cerr << "invalid phase threadcount: " << line << std::endl;
+      exit(1);
+    }
+    phases.push_back(phase);
+  }
+
+  if (phases.empty()) {
+    std::cerr << "no phases in " << phase_file << std::endl;
+    exit(1);
+  }
+  return phases;
+}
+
+// Forks a child process. Returns true in the child, whose stdout then goes to
+// the parent. The parent relays the child's output, each line prefixed with
+// prefix, waits for the child to exit and returns false.
+bool ForkRun(const std::string &prefix) {
+  std::cout << std::flush;
+  int fds[2];
+  if (pipe(fds) != 0) {
+    std::cerr << "pipe failed: " << std::strerror(errno) << std::endl;
+    exit(1);
+  }
+  pid_t pid = fork();
+  if (pid < 0) {
+    std::cerr << "fork failed: " << std::strerror(errno) << std::endl;
+    exit(1);
+  }
+  if (pid == 0) {
+    close(fds[0]);
+    dup2(fds[1], STDOUT_FILENO);
+    close(fds[1]);
+    setvbuf(stdout, nullptr, _IOLBF, 0);
+    return true;
+  }
+
+  close(fds[1]);
+  FILE *output = fdopen(fds[0], "r");
+  char *line = nullptr;
+  size_t line_cap = 0;
+  while (getline(&line, &line_cap, output) != -1) {
+    std::cout << prefix << line << std::flush;
+  }
+  free(line);
+  fclose(output);
+
+  int status;
+  waitpid(pid, &status, 0);
+  if (!WIFEXITED(status) || WEXITSTATUS(status) != 0) {
+    std::cerr << prefix << "run failed" << std::endl;
+    exit(1);
+  }
+  return false;
+}
+
+// Forks one child per combination of sweep.<property> values and trial, one
+// at a time. Each child starts from the loaded dataset. Returns true in the
+// children, with props set up for their run; the parent relays their output,
+// prefixed with the run number, and returns false once all runs are done.
+bool ForkSweepRuns(ycsbc::utils::Properties &props) {
+  const int trials = std::stoi(props.GetProperty("sweep.trials", "1"));
+  std::vector<std::pair<std::string, std::vector<std::string>>> axes;
+  for (const auto &prop : props.GetPropertiesWithPrefix("sweep.")) {
+    if (prop.first == "trials") {
+      continue;
+    }
+    std::vector<std::string> values;
+    std::istringstream tokens(prop.second);
+    std::string value;
+    while (std::getline(tokens, value, ',')) {
+      values.push_back(ycsbc::utils::Trim(value));
+    }
+    if (values.empty()) {
+      std::cerr << "no values to sweep for " << prop.first << std::endl;
+      exit(1);
+    }
+    axes.emplace_back(prop.first, values);
+  }
+
+  std::vector<size_t> index(axes.size(), 0);
+  int run = 0;
+  while (true) {
+    for (int trial = 1; trial <= trials; trial++) {
+      run++;
+      ycsbc::utils::Properties run_props = props;
+      std::string settings;
+      for (size_t i = 0; i < axes.size(); i++) {
+        run_props.SetProperty(axes[i].first, axes[i].second[index[i]]);
+        settings += axes[i].first + "=" + axes[i].second[index[i]] + " ";
+      }
+      settings += "trial=" + std::to_string(trial);
+      std::cout << "Sweep " << run << " settings: " << settings << std::endl;
+
+      if (ForkRun("Sweep " + std::to_string(run) + " ")) {
+        props = run_props;
+        return true;
+      }
+    }
+
+    // next combination, the first axis varying fastest
+    size_t axis = 0;
+    while (axis < axes.size() && ++index[axis] == axes[axis].second.size()) {
+      index[axis] = 0;
+      axis++;
+    }
+    if (axis == axes.size()) {
+      break;
+    }
+  }
+  return false;
+}
+
+// Per-window results of a compare run. Step is called through the barrier
+// each time all client threads have prepared a window or run it against one
+// engine; even windows run engine A first, odd windows engine B first.
+struct CompareResults {
+  ycsbc::Measurements *measurements[2];
+  std::vector<double> throughput[2];
+  std::vector<double> p50[2]; // in microseconds
+  std::vector<double> p99[2];
+  bool has_percentiles = true;
+  int step = 0;
+  std::chrono::steady_clock::time_point step_start;
+
+  void Step() {
+    const int window = step / 3;
+    const int part = step % 3;
+    if (part > 0) {
+      const int engine = ((part == 1) == (window % 2 == 0)) ? 0 : 1;
+      std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - step_start;
+      throughput[engine].push_back(measurements[engine]->GetTotalCount() / elapsed.count());
+      uint64_t latency;
+      if (measurements[engine]->GetPercentile(50, &latency)) {
+        p50[engine].push_back(latency / 1000.0);
+        measurements[engine]->GetPercentile(99, &latency);
+        p99[engine].push_back(latency / 1000.0);
+      } else {
+        has_percentiles = false;
+      }
+      measurements[engine]->Reset();
+    }
+    step++;
+    step_start = std::chrono::steady_clock::now();
+  }
+};
+
+struct CompareStep {
+  CompareResults *results;
+  void operator()() noexcept { results->Step(); }
+};
+
+void CompareThread(ycsbc::DB *a_db, ycsbc::DB *b_db, ycsbc::CoreWorkload *wl, int thread_id,
+                   int thread_count, int windows, int window_ops, bool init_db,
+                   std::barrier<CompareStep> *barrier) {
+  try {
+    if (init_db) {
+      a_db->Init();
+      b_db->Init();
+    }
+    ycsbc::ThreadState state = wl->InitThread(thread_id, thread_count);
+    std::vector<ycsbc::PendingTransaction> txns(window_ops);
+    for (int window = 0; window < windows; window++) {
+      for (auto &txn : txns) {
+        wl->ChooseTransaction(state, txn);
+      }
+      ycsbc::DB *first = (window % 2 == 0) ? a_db : b_db;
+      ycsbc::DB *second = (window % 2 == 0) ? b_db : a_db;
+      barrier->arrive_and_wait();
+      for (auto &txn : txns) {
+        wl->FinishTransaction(*first, state, txn);
+      }
+      barrier->arrive_and_wait();
+      for (auto &txn : txns) {
+        wl->ReplayTransaction(*second, txn);
+      }
+      barrier->arrive_and_wait();
+    }
+    a_db->Cleanup();
+    b_db->Cleanup();
+  } catch (const ycsbc::utils::Exception &e) {
+    std::cerr << "Caught exception: " << e.what() << std::endl;
+    exit(1);
+  }
+}
+
+// Two-sided 95% quantile of Student's t distribution
+double StudentT95(int df) {
+  static const double table[] = {
+    12.706, 4.303, 3.182, 2.776, 2.571, 2.447, 2.365, 2.306, 2.262, 2.228,
+    2.201, 2.179, 2.160, 2.145, 2.131, 2.120, 2.110, 2.101, 2.093, 2.086,
+    2.080, 2.074, 2.069, 2.064, 2.060, 2.056, 2.052, 2.048, 2.045, 2.042};
+  if (df <= 30) {
+    return table[df - 1];
+  }
+  return df <= 60 ? 2.000 : df <= 120 ? 1.980 : 1.960;
+}
+
+// Prints the mean of the per-window differences of b relative to a, in
+// percent, with its 95% confidence interval
+void PrintPairedDifference(const std::string &name, const std::vector<double> &a,
+                           const std::vector<double> &b) {
+  std::vector<double> diffs;
+  for (size_t i = 0; i < a.size(); i++) {
+    // a window with nothing to relate the difference to tells nothing
+    if (a[i] != 0) {
+      diffs.push_back((b[i] - a[i]) / a[i] * 100);
+    }
+  }
+  const size_t n = diffs.size();
+  if (n < a.size()) {
+    std::cout << "Compare " << name << " skipped windows: " << a.size() - n << std::endl;
+  }
+  if (n == 0) {
+    return;
+  }
+  double mean = std::accumulate(diffs.begin(), diffs.end(), 0.0) / n;
+  double var = 0;
+  for (double d : diffs) {
+    var += (d - mean) * (d - mean);
+  }
+  double half_width = n > 1 ? StudentT95(n - 1) * std::sqrt(var / (n - 1) / n) : 0;
+  std::cout << "Compare " << name << " difference(%): " << mean << std::endl;
+  std::cout << "Compare " << name << " difference 95% CI low(%): " << mean - half_width
+            << std::endl;
+  std::cout << "Compare " << name << " difference 95% CI high(%): " << mean + half_width
+            << std::endl;
+}
+
+void RunCompare(const std::vector<ycsbc::DB *> &a_dbs, const std::vector<ycsbc::DB *> &b_dbs,
+                ycsbc::Measurements *a_measurements, ycsbc::Measurements *b_measurements,
+                ycsbc::CoreWorkload &wl, const ycsbc::utils::Properties &props, bool init_db) {
+  const int windows = std::stoi(props.GetProperty("compare.windows", "20"));
+  const int window_ops = std::stoi(props.GetProperty("compare.windowops", "10000"));
+  const std::string names[2] = {props.GetProperty("dbname", "basic"),
+                                props.GetProperty("compare.dbname", "")};
+  const int num_threads = a_dbs.size();
+
+  CompareResults results;
+  results.measurements[0] = a_measurements;
+  results.measurements[1] = b_measurements;
+  std::barrier<CompareStep> barrier(num_threads, CompareStep{&results});
+
+  std::vector<std::future<void>> client_threads;
+  for (int i = 0; i < num_threads; ++i) {
+    client_threads.emplace_back(std::async(std::launch::async, CompareThread, a_dbs[i], b_dbs[i],
+                                           &wl, i, num_threads, windows, window_ops, init_db,
+                                           &barrier));
+  }
+  for (auto &n : client_threads) {
+    n.get();
+  }
+
+  std::cout << "Compare windows: " << windows << std::endl;
+  for (int engine = 0; engine < 2; engine++) {
+    const auto &tput = results.throughput[engine];
+    std::cout << "Compare " << names[engine] << " throughput(ops/sec): "
+              << std::accumulate(tput.begin(), tput.end(), 0.0) / tput.size() << std::endl;
+  }
+  PrintPairedDifference("throughput", results.throughput[0], results.throughput[1]);
+  if (results.has_percentiles) {
+    for (int engine = 0; engine < 2; engine++) {
+      const auto &p50 = results.p50[engine];
+      const auto &p99 = results.p99[engine];
+      std::cout << "Compare " << names[engine] << " p50 latency(us): "
+                << std::accumulate(p50.begin(), p50.end(), 0.0) / p50.size() << std::endl;
+      std::cout << "Compare " << names[engine] << " p99 latency(us): "
+                << std::accumulate(p99.begin(), p99.end(), 0.0) / p99.size() << std::endl;
+    }
+    PrintPairedDifference("p50 latency", results.p50[0], results.p50[1]);
+    PrintPairedDifference("p99 latency", results.p99[0], results.p99[1]);
+  }
+}
+
+// One point of the load-latency curve; latencies in microseconds
+struct RatePoint {
+  int64_t target; // ops/sec, unlimited if <= 0
+  double throughput;
+  double p50;
+  double p99;
+  double p999;
+  double slo_latency; // at slo.percentile
+};
+
+// Runs total_ops transactions on all client threads, together offering at
+// most target ops/sec, and measures the throughput and, if the measurements
+// track percentiles, the latency they reach
+RatePoint RunRateStep(const std::vector<ycsbc::DB *> &dbs, ycsbc::ClientThreadFunc client_thread,
+                      ycsbc::Measurements *measurements, ycsbc::CoreWorkload &wl,
+                      std::vector<ycsbc::ThreadState> &states, int64_t target,
+                      int64_t total_ops, double percentile, bool init_db) {
+  const int num_threads = dbs.size();
+  ycsbc::utils::CountDownLatch latch(num_threads);
+  ycsbc::utils::Timer<double> timer;
+
+  measurements->Reset();
+  timer.Start();
+  std::vector<std::future<int64_t>> client_threads;
+  std::vector<ycsbc::utils::RateLimiter *> rate_limiters;
+  for (int i = 0; i < num_threads; ++i) {
+    int64_t thread_ops = total_ops / num_threads;
+    if (i < total_ops % num_threads) {
+      thread_ops++;
+    }
+    ycsbc::utils::RateLimiter *rlim = nullptr;
+    if (target > 0) {
+      int64_t per_thread_ops = std::max<int64_t>(1, target / num_threads);
+      rlim = new ycsbc::utils::RateLimiter(per_thread_ops, per_thread_ops);
+    }
+    rate_limiters.push_back(rlim);
+    client_threads.emplace_back(std::async(std::launch::async, client_thread, dbs[i], &wl, i,
+                                           num_threads, thread_ops, false, init_db, false, &latch,
+                                           rlim, nullptr, &states[i]));
+  }
+  int64_t sum = 0;
+  for (auto &n : client_threads) {
+    sum += n.get();
+  }
+  double runtime = timer.End();
+  for (auto rlim : rate_limiters) {
+    delete rlim;
+  }
+
+  RatePoint point{};
+  point.target = target;
+  point.throughput = sum / runtime;
+  uint64_t latency;
+  if (measurements->GetPercentile(50, &latency)) {
+    point.p50 = latency / 1000.0;
+    measurements->GetPercentile(99, &latency);
+    point.p99 = latency / 1000.0;
+    measurements->GetPercentile(99.9, &latency);
+    point.p999 = latency / 1000.0;
+    measurements->GetPercentile(percentile, &latency);
+    point.slo_latency = latency / 1000.0;
+  }
+  return point;
+}
+
+void PrintRatePoint(const std::string &prefix, const RatePoint &point) {
+  std::cout << prefix << "target(ops/sec): " << point.target << std::endl;
+  std::cout << prefix << "throughput(ops/sec): " << point.throughput << std::endl;
+  std::cout << prefix << "p50 latency(us): " << point.p50 << std::endl;
+  std::cout << prefix << "p99 latency(us): " << point.p99 << std::endl;
+  std::cout << prefix << "p99.9 latency(us): " << point.p999 << std::endl;
+}
+
+// Finds the highest offered rate whose latency at slo.percentile stays within
+// slo.latency. A saturation run fixes the range, slo.steps evenly spaced rates
+// up to it trace the load-latency curve, and slo.searchsteps bisections
+// between the last rate meeting the SLO and the first one missing it refine
+// the capacity. Since the clients are rate limited rather than open loop, a
+// rate the clients fall short of does not show up as queueing latency; such
+// a rate counts as missing the SLO.
+void RunSloSearch(const std::vector<ycsbc::DB *> &dbs, ycsbc::ClientThreadFunc client_thread,
+                  ycsbc::Measurements *measurements, ycsbc::CoreWorkload &wl,
+                  const ycsbc::utils::Properties &props, bool init_db) {
+  const double slo_latency = std::stod(props.GetProperty("slo.latency"));
+  const double percentile = std::stod(props.GetProperty("slo.percentile", "99"));
+  const int steps = std::stoi(props.GetProperty("slo.steps", "10"));
+  const double step_duration = std::stod(props.GetProperty("slo.stepduration", "5"));
+  const int search_steps = std::stoi(props.GetProperty("slo.searchsteps", "6"));
+  const int64_t saturation_ops = std::stoll(props[ycsbc::CoreWorkload::OPERATION_COUNT_PROPERTY]);
+  uint64_t latency;
+  if (!measurements->GetPercentile(50, &latency)) {
+    std::cerr << "slo.latency needs measurementtype=hdrhistogram" << std::endl;
+    exit(1);
+  }
+  if (steps < 1 || step_duration <= 0) {
+    std::cerr << "slo.steps and slo.stepduration must be positive" << std::endl;
+    exit(1);
+  }
+
+  // the rate limiters let clients run this far below a target before the
+  // step counts as missing the SLO
+  const double min_throughput_ratio = 0.95;
+  // every step continues the clients' key sequences where the last one left them
+  std::vector<ycsbc::ThreadState> states;
+  for (size_t i = 0; i < dbs.size(); i++) {
+    states.push_back(wl.InitThread(i, dbs.size()));
+  }
+  auto run_step = [&](int64_t target) {
+    const int64_t ops = target > 0 ? target * step_duration : saturation_ops;
+    RatePoint point = RunRateStep(dbs, client_thread, measurements, wl, states, target, ops,
+                                  percentile, init_db);
+    init_db = false;
+    return point;
+  };
+  auto meets_slo = [&](const RatePoint &point) {
+    return point.slo_latency <= slo_latency &&
+           point.throughput >= min_throughput_ratio * point.target;
+  };
+
+  RatePoint saturation = run_step(0);
+  PrintRatePoint("Saturation ", saturation);
+
+  int64_t pass = 0;
+  int64_t fail = 0;
+  RatePoint capacity{};
+  for (int i = 1; i <= steps; i++) {
+    RatePoint point = run_step(saturation.throughput * i / steps);
+    PrintRatePoint("Curve " + std::to_string(i) + " ", point);
+    if (fail == 0 && meets_slo(point)) {
+      pass = point.target;
+      capacity = point;
+    } else if (fail == 0) {
+      fail = point.target;
+    }
+  }
+
+  for (int i = 1; i <= search_steps && fail - pass > 1; i++) {
+    RatePoint point = run_step((pass + fail) / 2);
+    PrintRatePoint("Search " + std::to_string(i) + " ", point);
+    if (meets_slo(point)) {
+      pass = point.target;
+      capacity = point;
+    } else {
+      fail = point.target;
+    }
+  }
+
+  for (auto db : dbs) {
+    db->Cleanup();
+  }
+
+  std::cout << "SLO p" << percentile << " latency(us): " << slo_latency << std::endl;
+  std::cout << "SLO capacity(ops/sec): " << pass << std::endl;
+  if (pass > 0) {
+    std::cout << "SLO capacity throughput(ops/sec): " << capacity.throughput << std::endl;
+    std::cout << "SLO capacity p" << percentile << " latency(us): " << capacity.slo_latency
+              << std::endl;
+  }
+}
+
+// Runs operationcount transactions once per intensity in interference.levels,
+// with every interference kind listed in interference running alongside the
+// clients at that intensity. Reports each level's throughput and latency,
+// and their change relative to the first level.
+void RunInterferenceLevels(const std::vector<ycsbc::DB *> &dbs,
+                           ycsbc::ClientThreadFunc client_thread,
+                           ycsbc::Measurements *measurements, ycsbc::CoreWorkload &wl,
+                           const ycsbc::utils::Properties &props, bool init_db) {
+  std::vector<ycsbc::utils::CacheInfo> caches = ycsbc::utils::GetCacheSizes();
+  const uint64_t llc_size = caches.empty() ? 32 << 20 : caches.back().size;
+  // size and cpus of each kind
+  struct Source {
+    ycsbc::utils::Interference::Kind kind;
+    uint64_t size;
+    std::vector<int> cpus;
+  };
+  std::vector<Source> sources;
+  std::istringstream kinds(props.GetProperty("interference"));
+  std::string name;
+  while (std::getline(kinds, name, ',')) {
+    name = ycsbc::utils::Trim(name);
+    Source source;
+    if (!ycsbc::utils::Interference::ParseKind(name, &source.kind)) {
+      std::cerr << "Unknown interference kind: " << name << std::endl;
+      exit(1);
+    }
+    const std::string size_default = source.kind == ycsbc::utils::Interference::STREAM
+        ? std::to_string(4 * llc_size)
+        : source.kind == ycsbc::utils::Interference::LLC ? std::to_string(llc_size)
+                                                          : std::to_string(1ULL << 30);
+    source.size = std::stoull(props.GetProperty("interference." + name + ".size", size_default));
+    source.cpus = ycsbc::utils::ParseCpuList(props.GetProperty("interference." + name + ".cpus", ""));
+    sources.push_back(source);
+  }
+  std::vector<double> levels;
+  std::istringstream level_tokens(props.GetProperty("interference.levels", "0,0.25,0.5,0.75,1"));
+  std::string level;
+  while (std::getline(level_tokens, level, ',')) {
+    levels.push_back(std::stod(level));
+    if (levels.back() < 0 || levels.back() > 1) {
+      std::cerr << "interference levels must be between 0 and 1" << std::endl;
+      exit(1);
+    }
+  }
+  if (sources.empty() || levels.empty()) {
+    std::cerr << "interference needs at least one kind and one level" << std::endl;
+    exit(1);
+  }
+
+  const int64_t total_ops = std::stoll(props[ycsbc::CoreWorkload::OPERATION_COUNT_PROPERTY]);
+  uint64_t latency;
+  const bool has_percentiles = measurements->GetPercentile(50, &latency);
+  std::vector<ycsbc::ThreadState> states;
+  for (size_t i = 0; i < dbs.size(); i++) {
+    states.push_back(wl.InitThread(i, dbs.size()));
+  }
+  RatePoint baseline{};
+  for (size_t i = 0; i < levels.size(); i++) {
+    std::vector<std::unique_ptr<ycsbc::utils::Interference>> running;
+    if (levels[i] > 0) {
+      for (auto &source : sources) {
+        running.emplace_back(new ycsbc::utils::Interference(source.kind, source.size, levels[i],
+                                                            source.cpus));
+      }
+    }
+    RatePoint point = RunRateStep(dbs, client_thread, measurements, wl, states, 0, total_ops, 99,
+                                  init_db);
+    running.clear();
+    init_db = false;
+    if (i == 0) {
+      baseline = point;
+    }
+
+    const std::string prefix = "Interference " + std::to_string(i + 1) + " ";
+    std::cout << prefix << "intensity: " << levels[i] << std::endl;
+    std::cout << prefix << "throughput(ops/sec): " << point.throughput << std::endl;
+    std::cout << prefix << "throughput change(%): "
+              << (point.throughput - baseline.throughput) / baseline.throughput * 100 << std::endl;
+    if (has_percentiles) {
+      std::cout << prefix << "p50 latency(us): " << point.p50 << std::endl;
+      std::cout << prefix << "p99 latency(us): " << point.p99 << std::endl;
+      std::cout << prefix << "p99.9 latency(us): " << point.p999 << std::endl;
+      std::cout << prefix << "p99 latency change(%): "
+                << (point.p99 - baseline.p99) / baseline.p99 * 100 << std::endl;
+    } else {
+      std::cout << prefix << "latency: " << measurements->GetStatusMsg() << std::endl;
+    }
+  }
+
+  for (auto db : dbs) {
+    db->Cleanup();
+  }
+}
+
+// Prints the number of stalls in a phase and the worst of them, and writes
+// the phase's timeline to timeline_file if not null
+void PrintTimeline(const std::string &phase, ycsbc::TimelineMeasurements *timeline,
+                   std::ofstream *timeline_file) {
+  const size_t kWorstStalls = 10;
+  std::vector<ycsbc::TimelineMeasurements::Stall> stalls = timeline->GetStalls();
+  std::sort(stalls.begin(), stalls.end(), [](const auto &a, const auto &b) {
+    return a.latency > b.latency;
+  });
+  stalls.resize(std::min(stalls.size(), kWorstStalls));
+  std::cout << phase << " stalls(count): " << timeline->GetStallCount() << std::endl;
+  for (size_t i = 0; i < stalls.size(); i++) {
+    const std::string prefix = phase + " stall " + std::to_string(i + 1) + " ";
+    std::cout << prefix << "time(sec): " << stalls[i].time / 1e9 << std::endl;
+    std::cout << prefix << "latency(us): " << stalls[i].latency / 1000.0 << std::endl;
+    std::cout << prefix << "records: " << stalls[i].records << std::endl;
+  }
+
+  if (timeline_file) {
+    uint64_t records = 0;
+    std::vector<ycsbc::TimelineMeasurements::Interval> intervals = timeline->GetTimeline();
+    for (size_t i = 0; i < intervals.size(); i++) {
+      records = std::max(records, intervals[i].records);
+      *timeline_file << phase << ',' << (i + 1) * timeline->interval() / 1e9 << ',' << records
+                     << ',' << intervals[i].inserts << ',' << intervals[i].mean_latency / 1000.0
+                     << ',' << intervals[i].max_latency / 1000.0 << '\n';
+    }
+    timeline_file->flush();
   }
+}
+
+// Inserts operationcount records with threadcount clients, at up to
+// growth.insertrate inserts per second, while growth.readers more clients
+// read existing records until the inserts are done
+void RunGrowth(const std::vector<ycsbc::DB *> &dbs, ycsbc::ClientThreadFunc client_thread,
+               ycsbc::TimelineMeasurements *timeline, ycsbc::CoreWorkload &wl,
+               ycsbc::utils::Properties &props, bool init_db, std::ofstream *timeline_file) {
+  const int num_threads = dbs.size();
+  const int num_readers = std::stoi(props.GetProperty("growth.readers", "0"));
+  const int64_t insert_rate = std::stoll(props.GetProperty("growth.insertrate", "0"));
+  const int64_t total_ops = std::stoll(props[ycsbc::CoreWorkload::OPERATION_COUNT_PROPERTY]);
+
+  // inserters and readers share the key space, so readers find every acknowledged insert
+  const std::string proportions[] = {
+      ycsbc::CoreWorkload::READ_PROPORTION_PROPERTY,
+      ycsbc::CoreWorkload::UPDATE_PROPORTION_PROPERTY,
+      ycsbc::CoreWorkload::INSERT_PROPORTION_PROPERTY,
+      ycsbc::CoreWorkload::SCAN_PROPORTION_PROPERTY,
+      ycsbc::CoreWorkload::READMODIFYWRITE_PROPORTION_PROPERTY,
+      ycsbc::CoreWorkload::DELETE_PROPORTION_PROPERTY};
+  ycsbc::utils::Properties insert_props = props;
+  ycsbc::utils::Properties read_props = props;
+  for (auto &proportion : proportions) {
+    insert_props.SetProperty(proportion, "0");
+    read_props.SetProperty(proportion, "0");
+  }
+  insert_props.SetProperty(ycsbc::CoreWorkload::INSERT_PROPORTION_PROPERTY, "1");
+  read_props.SetProperty(ycsbc::CoreWorkload::READ_PROPORTION_PROPERTY, "1");
+  read_props.SetProperty(ycsbc::CoreWorkload::REQUEST_DISTRIBUTION_PROPERTY,
+                         props.GetProperty("growth.requestdistribution", "latest"));
+  ycsbc::CoreWorkload insert_wl;
+  insert_wl.InitSharingKeySpace(insert_props, wl);
+  ycsbc::CoreWorkload read_wl;
+  read_wl.InitSharingKeySpace(read_props, wl);
 
+  std::vector<ycsbc::DB *> reader_dbs;
+  for (int i = 0; i < num_readers; i++) {
+    reader_dbs.push_back(ycsbc::DBFactory::CreateDB(&props, timeline));
+  }
+  std::vector<std::unique_ptr<ycsbc::utils::RateLimiter>> rate_limiters;
+  ycsbc::utils::ThreadControl reader_control;
+  ycsbc::utils::CountDownLatch latch(num_threads + num_readers);
+  ycsbc::utils::Timer<double> timer;
+
+  timer.Start();
+  std::vector<std::future<int64_t>> inserters;
   for (int i = 0; i < num_threads; i++) {
-    delete dbs[i];
+    int64_t thread_ops = total_ops / num_threads;
+    if (i < total_ops % num_threads) {
+      thread_ops++;
+    }
+    ycsbc::utils::RateLimiter *rlim = nullptr;
+    if (insert_rate > 0) {
+      const int64_t rate = std::max<int64_t>(1, insert_rate / num_threads);
+      rate_limiters.emplace_back(new ycsbc::utils::RateLimiter(rate, rate));
+      rlim = rate_limiters.back().get();
+    }
+    inserters.emplace_back(std::async(std::launch::async, client_thread, dbs[i], &insert_wl, i,
+                                      num_threads, thread_ops, false, init_db, true, &latch,
+                                      rlim, nullptr, nullptr));
+  }
+  std::vector<std::future<int64_t>> readers;
+  for (int i = 0; i < num_readers; i++) {
+    readers.emplace_back(std::async(std::launch::async, client_thread, reader_dbs[i], &read_wl,
+                                    i, num_readers, std::numeric_limits<int64_t>::max(), false,
+                                    true, true, &latch, nullptr, &reader_control, nullptr));
+  }
+
+  int64_t inserts = 0;
+  for (auto &n : inserters) {
+    inserts += n.get();
+  }
+  double runtime = timer.End();
+  reader_control.Stop();
+  int64_t reads = 0;
+  for (auto &n : readers) {
+    reads += n.get();
+  }
+  for (auto db : reader_dbs) {
+    delete db;
+  }
+
+  std::cout << "Run runtime(sec): " << runtime << std::endl;
+  std::cout << "Run operations(ops): " << inserts << std::endl;
+  std::cout << "Run throughput(ops/sec): " << inserts / runtime << std::endl;
+  std::cout << "Run read throughput(ops/sec): " << reads / runtime << std::endl;
+  std::cout << "Run latency: " << timeline->GetStatusMsg() << std::endl;
+  PrintTimeline("Run", timeline, timeline_file);
+}
+
+// Hands operationcount items from handoff.producers producer threads to
+// handoff.consumers consumer threads, produced at up to handoff.rate items
+// per second. The first threadcount threads use dbs, the rest DBs of their own
+void RunHandoff(const std::vector<ycsbc::DB *> &dbs, ycsbc::Measurements *measurements,
+                ycsbc::HandoffWorkload &wl, ycsbc::utils::Properties &props, bool init_db) {
+  const int num_threads = dbs.size();
+  const int producers = std::stoi(props.GetProperty("handoff.producers",
+                                                    std::to_string(std::max(1, num_threads / 2))));
+  const int consumers = std::stoi(props.GetProperty(
+      "handoff.consumers", std::to_string(std::max(1, num_threads - producers))));
+  const int64_t rate = std::stoll(props.GetProperty("handoff.rate", "0"));
+  const long max_time = std::stol(props.GetProperty("handoff.maxtime", "0"));
+  if (producers < 1 || consumers < 1) {
+    std::cerr << "handoff needs at least one producer and one consumer" << std::endl;
+    exit(1);
+  }
+  if (max_time < 0) {
+    std::cerr << "handoff.maxtime must not be negative" << std::endl;
+    exit(1);
+  }
+
+  ycsbc::Measurements *handoff_measurements = ycsbc::CreateMeasurements(&props);
+  std::vector<ycsbc::DB *> own_dbs;
+  std::vector<std::unique_ptr<ycsbc::utils::RateLimiter>> rate_limiters;
+  std::vector<uint64_t> misses(consumers);
+  std::vector<uint64_t> lost(consumers);
+  ycsbc::utils::ThreadControl control;
+  ycsbc::utils::CountDownLatch latch(producers + consumers);
+  ycsbc::utils::Timer<double> timer;
+
+  wl.SetProducerCount(producers);
+
+  timer.Start();
+  std::vector<std::future<int64_t>> producer_threads;
+  std::vector<std::future<int64_t>> consumer_threads;
+  for (int i = 0; i < producers + consumers; i++) {
+    ycsbc::DB *db;
+    bool init = init_db;
+    if (i < num_threads) {
+      db = dbs[i];
+    } else {
+      db = ycsbc::DBFactory::CreateDB(&props, measurements);
+      own_dbs.push_back(db);
+      init = true;
+    }
+    if (i < producers) {
+      ycsbc::utils::RateLimiter *rlim = nullptr;
+      if (rate > 0) {
+        const int64_t thread_rate = std::max<int64_t>(1, rate / producers);
+        rate_limiters.emplace_back(new ycsbc::utils::RateLimiter(thread_rate, thread_rate));
+        rlim = rate_limiters.back().get();
+      }
+      producer_threads.emplace_back(std::async(std::launch::async, ycsbc::HandoffClientThread,
+                                               db, &wl, i, producers, true, init, true, &latch,
+                                               rlim, &control, handoff_measurements, nullptr,
+                                               nullptr));
+    } else {
+      const int consumer = i - producers;
+      consumer_threads.emplace_back(std::async(std::launch::async, ycsbc::HandoffClientThread,
+                                               db, &wl, consumer, consumers, false, init, true,
+                                               &latch, nullptr, &control, handoff_measurements,
+                                               &misses[consumer], &lost[consumer]));
+    }
+  }
+  if (max_time > 0 && !latch.AwaitFor(max_time)) {
+    control.Stop();
+  }
+  int64_t produced = 0;
+  for (auto &n : producer_threads) {
+    produced += n.get();
+  }
+  int64_t consumed = 0;
+  for (auto &n : consumer_threads) {
+    consumed += n.get();
+  }
+  double runtime = timer.End();
+  for (auto db : own_dbs) {
+    delete db;
+  }
+
+  std::cout << "Run runtime(sec): " << runtime << std::endl;
+  std::cout << "Run operations(ops): " << consumed << std::endl;
+  std::cout << "Run throughput(ops/sec): " << consumed / runtime << std::endl;
+  std::cout << "Handoff producers: " << producers << std::endl;
+  std::cout << "Handoff consumers: " << consumers << std::endl;
+  std::cout << "Handoff produced(ops): " << produced << std::endl;
+  std::cout << "Handoff failed(inserts): " << wl.failed_inserts() << std::endl;
+  std::cout << "Handoff lost(items): " << std::accumulate(lost.begin(), lost.end(), 0ULL)
+            << std::endl;
+  std::cout << "Handoff misses(reads): " << std::accumulate(misses.begin(), misses.end(), 0ULL)
+            << std::endl;
+  uint64_t latency;
+  if (handoff_measurements->GetPercentile(50, &latency)) {
+    std::cout << "Handoff p50 latency(us): " << latency / 1000.0 << std::endl;
+    handoff_measurements->GetPercentile(99, &latency);
+    std::cout << "Handoff p99 latency(us): " << latency / 1000.0 << std::endl;
+  }
+  std::cout << "Handoff latency: " << handoff_measurements->GetStatusMsg() << std::endl;
+  delete handoff_measurements;
+}
+
+// Forks one child per record count, from sizesweep.min growing geometrically
+// by sizesweep.factor up to sizesweep.max. Each child loads and runs its own
+// table. Returns true in the children, with recordcount set; the parent
+// prints the cache sizes, relays the children's output and returns false.
+bool ForkSizeSweepRuns(ycsbc::utils::Properties &props) {
+  std::vector<ycsbc::utils::CacheInfo> caches = ycsbc::utils::GetCacheSizes();
+  for (auto &cache : caches) {
+    std::cout << "Cache " << cache.name << " size(bytes): " << cache.size << std::endl;
+  }
+
+  // by default, from L1-sized to four times LLC-sized, estimating a record
+  // by its field data
+  const uint64_t record_bytes =
+      std::stoi(props.GetProperty(ycsbc::CoreWorkload::FIELD_COUNT_PROPERTY,
+                                  ycsbc::CoreWorkload::FIELD_COUNT_DEFAULT)) *
+      std::stoi(props.GetProperty(ycsbc::CoreWorkload::FIELD_LENGTH_PROPERTY,
+                                  ycsbc::CoreWorkload::FIELD_LENGTH_DEFAULT));
+  const uint64_t min_default = caches.empty() ? 1000 : caches.front().size / record_bytes;
+  const uint64_t max_default = caches.empty() ? 10000000 : 4 * caches.back().size / record_bytes;
+  const uint64_t min_count = std::stoull(props.GetProperty("sizesweep.min",
+                                                           std::to_string(min_default)));
+  const uint64_t max_count = std::stoull(props.GetProperty("sizesweep.max",
+                                                           std::to_string(max_default)));
+  const double factor = std::stod(props.GetProperty("sizesweep.factor", "2"));
+  if (min_count < 1 || factor <= 1) {
+    std::cerr << "sizesweep.min must be positive and sizesweep.factor above 1" << std::endl;
+    exit(1);
+  }
+
+  int run = 0;
+  for (double count = min_count; count <= max_count; count *= factor) {
+    run++;
+    const uint64_t record_count = count;
+    std::cout << "Size " << run << " recordcount: " << record_count << std::endl;
+    if (ForkRun("Size " + std::to_string(run) + " ")) {
+      props.SetProperty(ycsbc::CoreWorkload::RECORD_COUNT_PROPERTY, std::to_string(record_count));
+      return true;
+    }
+  }
+  return false;
+}
+
+ycsbc::Generator<uint64_t> *CreateThinkTimeGenerator(const ycsbc::utils::Properties &props) {
+  // mean think time in microseconds
+  const double mean = std::stod(props.GetProperty("clients.thinktime", "0"));
+  const std::string dist = props.GetProperty("clients.thinktimedistribution", "exponential");
+  if (mean <= 0) {
+    return new ycsbc::ConstGenerator(0);
+  } else if (dist == "constant") {
+    return new ycsbc::ConstGenerator(mean);
+  } else if (dist == "uniform") {
+    return new ycsbc::UniformGenerator(0, 2 * mean);
+  } else if (dist == "exponential") {
+    return new ycsbc::ExponentialGenerator(mean);
+  }
+  std::cerr << "Unknown think time distribution: " << dist << std::endl;
+  exit(1);
+}
+
+std::vector<ThreadGroup> ParseThreadGroups(const ycsbc::utils::Properties &props,
+                                          const ycsbc::utils::Properties &command_line) {
+  // group.<name>.threads, group.<name>.P and group.<name>.<property> overrides
+  std::map<std::string, std::map<std::string, std::string>> group_props;
+  for (const auto &prop : props.GetPropertiesWithPrefix("group.")) {
+    size_t dot = prop.first.find('.');
+    if (dot == std::string::npos) {
+      std::cerr << "Invalid thread group property: group." << prop.first << std::endl;
+      exit(1);
+    }
+    group_props[prop.first.substr(0, dot)][prop.first.substr(dot + 1)] = prop.second;
   }
+
+  std::vector<ThreadGroup> groups;
+  for (auto &group_prop : group_props) {
+    ThreadGroup group{};
+    group.name = group_prop.first;
+    group.props = props;
+    auto &overrides = group_prop.second;
+    if (overrides.count("P")) {
+      std::ifstream input(overrides["P"]);
+      try {
+        group.props.Load(input);
+      } catch (const ycsbc::utils::Exception &e) {
+        std::cerr << "Failed to load " << overrides["P"] << " for thread group "
+                  << group.name << ": " << e.what() << std::endl;
+        exit(1);
+      }
+      // the command line still wins over the group's file, as over the global ones
+      for (const auto &prop : command_line.GetPropertiesWithPrefix("")) {
+        group.props.SetProperty(prop.first, prop.second);
+      }
+    }
+    for (auto &prop : overrides) {
+      if (prop.first != "P" && prop.first != "threads") {
+        group.props.SetProperty(prop.first, prop.second);
+      }
+    }
+    group.num_threads = std::stoi(overrides.count("threads") ? overrides["threads"] : "0");
+    if (group.num_threads <= 0) {
+      std::cerr << "Thread group " << group.name << " needs group." << group.name
+                << ".threads > 0" << std::endl;
+      exit(1);
+    }
+    group.measurements = ycsbc::CreateMeasurements(&group.props);
+    if (group.measurements == nullptr) {
+      std::cerr << "Unknown measurements name" << std::endl;
+      exit(1);
+    }
+    groups.push_back(std::move(group));
+  }
+  return groups;
 }
 
-void ParseCommandLine(int argc, const char *argv[], ycsbc::utils::Properties &props) {
+void RunThreadGroups(std::vector<ThreadGroup> &groups, bool show_status, int status_interval) {
+  int total_threads = 0;
+  for (auto &group : groups) {
+    for (int i = 0; i < group.num_threads; i++) {
+      ycsbc::DB *db = ycsbc::DBFactory::CreateDB(&group.props, group.measurements);
+      if (db == nullptr) {
+        std::cerr << "Unknown database name " << group.props["dbname"] << std::endl;
+        exit(1);
+      }
+      group.dbs.push_back(db);
+    }
+    total_threads += group.num_threads;
+  }
+
+  ycsbc::utils::CountDownLatch latch(total_threads);
+  ycsbc::utils::Timer<double> timer;
+
+  timer.Start();
+  std::future<void> status_future;
+  if (show_status) {
+    StatusSources sources;
+    for (auto &group : groups) {
+      sources.emplace_back(group.name, group.measurements);
+    }
+    status_future = std::async(std::launch::async, StatusThread, sources, &latch, status_interval);
+  }
+
+  // thread ids are global so that per-client key layouts do not collide across groups
+  auto run_group = [&latch, total_threads](ThreadGroup *group, int first_thread_id) {
+    ycsbc::utils::Timer<double> group_timer;
+    group_timer.Start();
+
+    const int64_t total_ops =
+        std::stoll(group->props[ycsbc::CoreWorkload::OPERATION_COUNT_PROPERTY]);
+    const int64_t ops_limit = std::stoll(group->props.GetProperty("limit.ops", "0"));
+    std::vector<std::future<int64_t>> client_threads;
+    std::vector<ycsbc::utils::RateLimiter *> rate_limiters;
+    for (int i = 0; i < group->num_threads; ++i) {
+      int64_t thread_ops = total_ops / group->num_threads;
+      if (i < total_ops % group->num_threads) {
+        thread_ops++;
+      }
+      ycsbc::utils::RateLimiter *rlim = nullptr;
+      if (ops_limit > 0) {
+        int64_t per_thread_ops = ops_limit / group->num_threads;
+        rlim = new ycsbc::utils::RateLimiter(per_thread_ops, per_thread_ops);
+      }
+      rate_limiters.push_back(rlim);
+      client_threads.emplace_back(std::async(std::launch::async, ycsbc::ClientThread,
+                                             group->dbs[i], group->wl, first_thread_id + i,
+                                             total_threads, thread_ops, false, true, true,
+                                             &latch, rlim, nullptr, nullptr));
+    }
+
+    group->ops = 0;
+    for (auto &n : client_threads) {
+      group->ops += n.get();
+    }
+    group->runtime = group_timer.End();
+    for (auto rlim : rate_limiters) {
+      delete rlim;
+    }
+  };
+
+  std::vector<std::future<void>> group_futures;
+  int first_thread_id = 0;
+  for (auto &group : groups) {
+    group_futures.emplace_back(std::async(std::launch::async, run_group, &group, first_thread_id));
+    first_thread_id += group.num_threads;
+  }
+
+  int64_t sum = 0;
+  for (size_t i = 0; i < groups.size(); i++) {
+    group_futures[i].wait();
+    sum += groups[i].ops;
+  }
+  double runtime = timer.End();
+
+  if (show_status) {
+    status_future.wait();
+  }
+
+  std::cout << "Run runtime(sec): " << runtime << std::endl;
+  std::cout << "Run operations(ops): " << sum << std::endl;
+  std::cout << "Run throughput(ops/sec): " << sum / runtime << std::endl;
+  for (auto &group : groups) {
+    std::cout << "Group " << group.name << " runtime(sec): " << group.runtime << std::endl;
+    std::cout << "Group " << group.name << " operations(ops): " << group.ops << std::endl;
+    std::cout << "Group " << group.name << " throughput(ops/sec): "
+              << group.ops / group.runtime << std::endl;
+    std::cout << "Group " << group.name << " latency: "
+              << group.measurements->GetStatusMsg() << std::endl;
+  }
+}
+
+void ParseCommandLine(int argc, const char *argv[], ycsbc::utils::Properties &props,
+                      ycsbc::utils::Properties &command_line) {
+  // options other than -P override property files, here and in thread groups
+  auto set_property = [&](const std::string &key, const std::string &value) {
+    props.SetProperty(key, value);
+    command_line.SetProperty(key, value);
+  };
   int argindex = 1;
   while (argindex < argc && StrStartWith(argv[argindex], "-")) {
     if (strcmp(argv[argindex], "-load") == 0) {
-      props.SetProperty("doload", "true");
+      set_property("doload", "true");
       argindex++;
     } else if (strcmp(argv[argindex], "-run") == 0 || strcmp(argv[argindex], "-t") == 0) {
-      props.SetProperty("dotransaction", "true");
+      set_property("dotransaction", "true");
       argindex++;
     } else if (strcmp(argv[argindex], "-threads") == 0) {
       argindex++;
@@ -244,7 +1847,7 @@ void ParseCommandLine(int argc, const char *argv[], ycsbc::utils::Properties &pr
         std::cerr << "Missing argument value for -threads" << std::endl;
         exit(0);
       }
-      props.SetProperty("threadcount", argv[argindex]);
+      set_property("threadcount", argv[argindex]);
       argindex++;
     } else if (strcmp(argv[argindex], "-db") == 0) {
       argindex++;
@@ -253,7 +1856,7 @@ void ParseCommandLine(int argc, const char *argv[], ycsbc::utils::Properties &pr
         std::cerr << "Missing argument value for -db" << std::endl;
         exit(0);
       }
-      props.SetProperty("dbname", argv[argindex]);
+      set_property("dbname", argv[argindex]);
       argindex++;
     } else if (strcmp(argv[argindex], "-P") == 0) {
       argindex++;
@@ -286,11 +1889,11 @@ void ParseCommandLine(int argc, const char *argv[], ycsbc::utils::Properties &pr
                      "(e.g., -p operationcount=99999)" << std::endl;
         exit(0);
       }
-      props.SetProperty(ycsbc::utils::Trim(prop.substr(0, eq)),
-                        ycsbc::utils::Trim(prop.substr(eq + 1)));
+      set_property(ycsbc::utils::Trim(prop.substr(0, eq)),
+                   ycsbc::utils::Trim(prop.substr(eq + 1)));
       argindex++;
     } else if (strcmp(argv[argindex], "-s") == 0) {
-      props.SetProperty("status", "true");
+      set_property("status", "true");
       argindex++;
     } else {
       UsageMessage(argv[0]);
@@ -12,7 +12,7 @@
 
 namespace ycsbc {
 
-class gsm_db : public DB {
+class gsm_db final : public DB {
   public:
     gsm_db() = default;
 
@@ -12,7 +12,7 @@
 
 namespace ycsbc {
 
-class gsm_diom_ii_db : public DB {
+class gsm_diom_ii_db final : public DB {
   public:
     gsm_diom_ii_db() = default;
 
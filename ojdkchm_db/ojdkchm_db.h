@@ -12,7 +12,7 @@
 
 namespace ycsbc {
 
-class ojdkchm_db : public DB {
+class ojdkchm_db final : public DB {
   public:
     ojdkchm_db() = default;
 
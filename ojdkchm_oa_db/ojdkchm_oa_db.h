@@ -12,7 +12,7 @@
 
 namespace ycsbc {
 
-class ojdkchm_oa_db : public DB {
+class ojdkchm_oa_db final : public DB {
   public:
     ojdkchm_oa_db() = default;
 
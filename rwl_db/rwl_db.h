@@ -12,7 +12,7 @@
 
 namespace ycsbc {
 
-class rwl_db : public DB {
+class rwl_db final : public DB {
   public:
     rwl_db() = default;
 
@@ -16,6 +16,9 @@ parser.add_argument("-d", "--db", nargs="+", help="Database(s) to benchmark")
 parser.add_argument("-w", "--workload", nargs="+", help="Workloads on which to benchmark")
 parser.add_argument("-m", "--max-threads", type=int, default=1, help="Max number of threads to run on each configuration")
 parser.add_argument("-t", "--trials", type=int, default=1, help="Number of trials of configuration to run")
+parser.add_argument("--slo", type=float, help="Find the highest rate each database sustains at p99 below this many microseconds, and record its load-latency curve")
+parser.add_argument("--client-loop", action="store_true", help="Measure client overhead: run each workload on null_db with clientloop=static and clientloop=virtual, at every thread count")
+parser.add_argument("-s", "--sweep", action="store_true", help="Load once per database and workload, and fork every thread count, distribution and trial from the loaded dataset")
 
 @dataclass
 class TrialConfig:
@@ -31,6 +34,7 @@ dbs = []
 workloads = []
 max_threads = 0
 trials = 0
+slo = None
 
 def bench_one(cfg):
     c = cfg.cmd()
@@ -97,6 +101,118 @@ def bench_one(cfg):
 
     return data
 
+def bench_sweep(db_name, workload):
+    c = (f"/usr/bin/time -v ../build/ycsb -db {db_name} -load -run -P ../workloads/workload{workload}"
+         f" -p sweep.threadcount={','.join(str(t) for t in range(1, max_threads + 1))}"
+         f" -p sweep.requestdistribution=uniform,zipfian -p sweep.trials={trials}")
+    print(f"$ {c}")
+    r = subprocess.run(c, capture_output=True, text=True, shell=True, check=True)
+
+    load = {"runtime": None, "operations": None, "throughput": None}
+    tot = {"max rss": None, "avg rss": None}
+    runs = {}
+    for o in r.stdout.strip().splitlines():
+        metric_name, raw_metric_data = o.split(": ", 1)
+        words = metric_name.split(" ")
+        if words[0] == "Sweep" and words[2] == "settings":
+            settings = dict(s.split("=") for s in raw_metric_data.split(" "))
+            cfg = TrialConfig(db_name, workload, int(settings["threadcount"]), settings["requestdistribution"])
+            runs[words[1]] = (cfg, {"runtime": None, "operations": None, "throughput": None})
+            continue
+        if words[0] == "Sweep":
+            data_metric_cat = runs[words[1]][1]
+            metric_name = " ".join(words[2:])
+        elif "Load" in metric_name:
+            data_metric_cat = load
+        else:
+            continue
+
+        if "runtime" in metric_name:
+            data_metric_cat["runtime"] = float(raw_metric_data)
+        elif "operations" in metric_name:
+            data_metric_cat["operations"] = float(raw_metric_data)
+        elif "throughput" in metric_name:
+            data_metric_cat["throughput"] = float(raw_metric_data)
+
+    for e in r.stderr.strip().splitlines():
+        metric_name, raw_metric_data = e.split(": ")
+        if "Maximum resident set size" in metric_name:
+            tot["max rss"] = float(raw_metric_data)
+        elif "Average resident set size" in metric_name:
+            tot["avg rss"] = float(raw_metric_data)
+
+    return [(cfg, {"load": load, "run": run, "tot": tot}) for cfg, run in runs.values()]
+
+def bench_slo(db_name, workload):
+    c = (f"../build/ycsb -db {db_name} -threads {max_threads} -load -run -P ../workloads/workload{workload}"
+         f" -p measurementtype=hdrhistogram -p slo.latency={slo}")
+    print(f"$ {c}")
+    r = subprocess.run(c, capture_output=True, text=True, shell=True, check=True)
+
+    # one point per Saturation, Curve <n> and Search <n> step, in run order
+    points = {}
+    data = {"curve": [], "capacity": None}
+    for o in r.stdout.strip().splitlines():
+        metric_name, raw_metric_data = o.split(": ", 1)
+        words = metric_name.split(" ")
+        if words[0] == "SLO" and words[1] == "capacity(ops/sec)":
+            data["capacity"] = float(raw_metric_data)
+            continue
+        if words[0] == "Saturation":
+            step, metric = "Saturation", " ".join(words[1:])
+        elif words[0] in ("Curve", "Search"):
+            step, metric = " ".join(words[:2]), " ".join(words[2:])
+        else:
+            continue
+        if step not in points:
+            points[step] = {"step": step}
+            data["curve"].append(points[step])
+        points[step][metric] = float(raw_metric_data)
+
+    return data
+
+def bench_client_loop(workload, threads, client_loop):
+    c = (f"../build/ycsb -db null_db -threads {threads} -load -run -P ../workloads/workload{workload}"
+         f" -p clientloop={client_loop}")
+    print(f"$ {c}")
+    r = subprocess.run(c, capture_output=True, text=True, shell=True, check=True)
+
+    data = {"runtime": None, "operations": None, "throughput": None}
+    for o in r.stdout.strip().splitlines():
+        metric_name, raw_metric_data = o.split(": ", 1)
+        if not metric_name.startswith("Run "):
+            continue
+        if "runtime" in metric_name:
+            data["runtime"] = float(raw_metric_data)
+        elif "operations" in metric_name:
+            data["operations"] = float(raw_metric_data)
+        elif "throughput" in metric_name:
+            data["throughput"] = float(raw_metric_data)
+
+    return data
+
+def write_client_loop(workload, threads, client_loop, data):
+    try:
+        with open("../clientloop_data.json", "r") as f:
+            old_data = json.load(f)
+    except:
+        old_data = {}
+
+    old_data.setdefault(workload, {}).setdefault(str(threads), {}).setdefault(client_loop, []).append(data)
+    with open("../clientloop_data.json", "w") as f:
+        json.dump(old_data, f, indent=4)
+
+def write_slo(db_name, workload, data):
+    try:
+        with open("../slo_data.json", "r") as f:
+            old_data = json.load(f)
+    except:
+        old_data = {}
+
+    old_data.setdefault(db_name, {})[workload] = data
+    with open("../slo_data.json", "w") as f:
+        json.dump(old_data, f, indent=4)
+
 def write_one(cfg, data):
     try:
         with open("../raw_data.json", "r") as f:
@@ -117,13 +233,35 @@ def write_one(cfg, data):
         json.dump(old_data, f, indent=4)
 
 def main():
-    global dbs, workloads, max_threads, trials
+    global dbs, workloads, max_threads, trials, slo
 
     args = parser.parse_args()
     dbs = args.db
     workloads = args.workload
     max_threads = args.max_threads
     trials = args.trials
+    slo = args.slo
+
+    if slo is not None:
+        for db in dbs:
+            for work in workloads:
+                write_slo(db, work, bench_slo(db, work))
+        return
+
+    if args.client_loop:
+        for tc in range(1, max_threads + 1):
+            for work in workloads:
+                for tr in range(trials):
+                    for client_loop in ["static", "virtual"]:
+                        write_client_loop(work, tc, client_loop, bench_client_loop(work, tc, client_loop))
+        return
+
+    if args.sweep:
+        for db in dbs:
+            for work in workloads:
+                for cfg, data in bench_sweep(db, work):
+                    write_one(cfg, data)
+        return
 
     for tc in range(1, max_threads + 1):
         for db in dbs:
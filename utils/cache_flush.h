@@ -0,0 +1,92 @@
+//
+//  cache_flush.h
+//  YCSB-cpp
+//
+//  Evicts the caller's working set from the CPU caches and TLBs.
+//
+
+#ifndef YCSB_C_CACHE_FLUSH_H_
+#define YCSB_C_CACHE_FLUSH_H_
+
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include "utils.h"
+
+namespace ycsbc {
+
+namespace utils {
+
+///
+/// Flush reads every cache line of a flush_bytes buffer, which should be
+/// larger than the last-level cache, and then one line of each of tlb_pages
+/// small pages, which should outnumber the TLB entries. Flush only reads,
+/// so any number of threads may flush at once.
+///
+class CacheFlusher {
+ public:
+  CacheFlusher(uint64_t flush_bytes, uint64_t tlb_pages)
+      : page_size_(sysconf(_SC_PAGESIZE)), flush_bytes_(flush_bytes),
+        tlb_bytes_(tlb_pages * page_size_) {
+    buffer_ = Map(flush_bytes_);
+    tlb_buffer_ = tlb_bytes_ > 0 ? Map(tlb_bytes_) : nullptr;
+    if (tlb_buffer_) {
+      // huge pages would cover the region with a handful of TLB entries
+      madvise(tlb_buffer_, tlb_bytes_, MADV_NOHUGEPAGE);
+    }
+    std::memset(buffer_, 1, flush_bytes_);
+    for (uint64_t offset = 0; offset < tlb_bytes_; offset += page_size_) {
+      tlb_buffer_[offset] = 1;
+    }
+  }
+
+  ~CacheFlusher() {
+    munmap(buffer_, flush_bytes_);
+    if (tlb_buffer_) {
+      munmap(tlb_buffer_, tlb_bytes_);
+    }
+  }
+
+  CacheFlusher(const CacheFlusher &) = delete;
+  CacheFlusher &operator=(const CacheFlusher &) = delete;
+
+  void Flush() const {
+    uint64_t sum = 0;
+    for (uint64_t offset = 0; offset < flush_bytes_; offset += kLineSize) {
+      sum += buffer_[offset];
+    }
+    for (uint64_t offset = 0; offset < tlb_bytes_; offset += page_size_) {
+      sum += tlb_buffer_[offset];
+    }
+    sink_.fetch_add(sum, std::memory_order_relaxed);
+  }
+
+ private:
+  static constexpr uint64_t kLineSize = 64;
+
+  static char *Map(uint64_t bytes) {
+    void *p = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (p == MAP_FAILED) {
+      throw Exception("failed to map " + std::to_string(bytes) + " bytes for cache flushing");
+    }
+    return static_cast<char *>(p);
+  }
+
+  const uint64_t page_size_;
+  const uint64_t flush_bytes_;
+  const uint64_t tlb_bytes_;
+  char *buffer_;
+  char *tlb_buffer_;
+  // keeps the reads from being optimized away
+  mutable std::atomic<uint64_t> sink_{0};
+};
+
+} // utils
+
+} // ycsbc
+
+#endif // YCSB_C_CACHE_FLUSH_H_
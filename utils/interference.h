@@ -0,0 +1,191 @@
+//
+//  interference.h
+//  YCSB-cpp
+//
+//  Background load that competes with the client threads for memory
+//  bandwidth, last-level cache and memory.
+//
+
+#ifndef YCSB_C_INTERFERENCE_H_
+#define YCSB_C_INTERFERENCE_H_
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <pthread.h>
+#include <sched.h>
+#include <unistd.h>
+
+#include "utils.h"
+
+namespace ycsbc {
+
+namespace utils {
+
+///
+/// Parses a CPU list such as "0,2-3".
+///
+inline std::vector<int> ParseCpuList(const std::string &list) {
+  std::vector<int> cpus;
+  std::istringstream tokens(list);
+  std::string token;
+  while (std::getline(tokens, token, ',')) {
+    token = Trim(token);
+    if (token.empty()) {
+      continue;
+    }
+    size_t dash = token.find('-');
+    int first = std::stoi(token.substr(0, dash));
+    int last = dash == std::string::npos ? first : std::stoi(token.substr(dash + 1));
+    for (int cpu = first; cpu <= last; cpu++) {
+      cpus.push_back(cpu);
+    }
+  }
+  return cpus;
+}
+
+///
+/// Pins the calling thread to cpu. Returns false if cpu is not available.
+///
+inline bool PinThread(int cpu) {
+  cpu_set_t set;
+  CPU_ZERO(&set);
+  CPU_SET(cpu, &set);
+  return pthread_setaffinity_np(pthread_self(), sizeof(set), &set) == 0;
+}
+
+///
+/// A background load running from construction to destruction, on one
+/// thread per CPU in cpus, or on one unpinned thread if cpus is empty.
+///
+/// STREAM threads read and write their share of a size-byte buffer
+/// sequentially, using memory bandwidth. LLC threads write random cache
+/// lines of their share of a size-byte buffer, evicting the lines of other
+/// threads from the last-level cache. Both work for intensity of every
+/// millisecond and sleep for the rest. A BALLOON holds intensity x size
+/// bytes, rewriting each page every 100 milliseconds to keep it resident.
+///
+class Interference {
+ public:
+  enum Kind { STREAM, LLC, BALLOON };
+
+  Interference(Kind kind, uint64_t size, double intensity, const std::vector<int> &cpus)
+      : kind_(kind), intensity_(intensity), stop_(false) {
+    if (kind == BALLOON) {
+      size = size * intensity;
+    }
+    const int num_threads = cpus.empty() ? 1 : cpus.size();
+    const uint64_t share = size / num_threads;
+    for (int i = 0; i < num_threads; i++) {
+      buffers_.emplace_back(new char[share]);
+      std::memset(buffers_[i].get(), 0, share);
+    }
+    for (int i = 0; i < num_threads; i++) {
+      threads_.emplace_back(&Interference::Run, this, buffers_[i].get(), share,
+                            cpus.empty() ? -1 : cpus[i]);
+    }
+  }
+
+  ~Interference() {
+    stop_ = true;
+    for (auto &thread : threads_) {
+      thread.join();
+    }
+  }
+
+  Interference(const Interference &) = delete;
+  Interference &operator=(const Interference &) = delete;
+
+  static bool ParseKind(const std::string &name, Kind *kind) {
+    if (name == "stream") {
+      *kind = STREAM;
+    } else if (name == "llc") {
+      *kind = LLC;
+    } else if (name == "balloon") {
+      *kind = BALLOON;
+    } else {
+      return false;
+    }
+    return true;
+  }
+
+ private:
+  static constexpr uint64_t kLineSize = 64;
+  static constexpr uint64_t kStreamChunk = 64 * 1024;
+  static constexpr int kLlcChunk = 1024;
+
+  void Run(char *buffer, uint64_t size, int cpu) {
+    using Clock = std::chrono::steady_clock;
+    if (cpu >= 0 && !PinThread(cpu)) {
+      std::cerr << "failed to pin interference thread to cpu " << cpu << std::endl;
+      exit(1);
+    }
+    if (size < kStreamChunk) {
+      return;
+    }
+
+    if (kind_ == BALLOON) {
+      const uint64_t page_size = sysconf(_SC_PAGESIZE);
+      while (!stop_.load(std::memory_order_relaxed)) {
+        for (uint64_t offset = 0; offset < size; offset += page_size) {
+          buffer[offset]++;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+      }
+      return;
+    }
+
+    const auto period = std::chrono::milliseconds(1);
+    const auto busy = std::chrono::duration_cast<Clock::duration>(period * intensity_);
+    const uint64_t num_lines = size / kLineSize;
+    uint64_t offset = 0;
+    uint64_t line = 88172645463325252ULL ^ reinterpret_cast<uintptr_t>(buffer);
+    uint64_t sum = 0;
+    while (!stop_.load(std::memory_order_relaxed)) {
+      Clock::time_point start = Clock::now();
+      do {
+        if (kind_ == STREAM) {
+          for (uint64_t i = offset; i < offset + kStreamChunk; i += kLineSize) {
+            sum += buffer[i];
+          }
+          std::memset(buffer + offset, static_cast<char>(sum), kStreamChunk);
+          offset += kStreamChunk;
+          if (offset + kStreamChunk > size) {
+            offset = 0;
+          }
+        } else {
+          for (int i = 0; i < kLlcChunk; i++) {
+            line ^= line << 13;
+            line ^= line >> 7;
+            line ^= line << 17;
+            buffer[line % num_lines * kLineSize]++;
+          }
+        }
+      } while (Clock::now() - start < busy);
+      if (busy < period) {
+        std::this_thread::sleep_until(start + period);
+      }
+    }
+  }
+
+  const Kind kind_;
+  const double intensity_;
+  std::atomic<bool> stop_;
+  std::vector<std::unique_ptr<char[]>> buffers_;
+  std::vector<std::thread> threads_;
+};
+
+} // utils
+
+} // ycsbc
+
+#endif // YCSB_C_INTERFERENCE_H_
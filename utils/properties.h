@@ -27,6 +27,7 @@ class Properties {
   const std::string &operator[](const std::string &key) const;
   void SetProperty(const std::string &key, const std::string &value);
   bool ContainsKey(const std::string &key) const;
+  std::map<std::string, std::string> GetPropertiesWithPrefix(const std::string &prefix) const;
   void Load(std::ifstream &input);
  private:
   std::map<std::string, std::string> properties_;
@@ -54,6 +55,19 @@ inline bool Properties::ContainsKey(const std::string &key) const {
   return properties_.find(key) != properties_.end();
 }
 
+///
+/// Returns all properties whose key starts with prefix, keyed by the rest of the key.
+///
+inline std::map<std::string, std::string> Properties::GetPropertiesWithPrefix(
+    const std::string &prefix) const {
+  std::map<std::string, std::string> result;
+  for (auto it = properties_.lower_bound(prefix);
+       it != properties_.end() && it->first.compare(0, prefix.size(), prefix) == 0; ++it) {
+    result[it->first.substr(prefix.size())] = it->second;
+  }
+  return result;
+}
+
 inline void Properties::Load(std::ifstream &input) {
   if (!input.is_open()) {
     throw Exception("File not open!");
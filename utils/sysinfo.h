@@ -0,0 +1,82 @@
+//
+//  sysinfo.h
+//  YCSB-cpp
+//
+//  Cache sizes and memory usage of the host, read from sysfs and procfs.
+//
+
+#ifndef YCSB_C_SYSINFO_H_
+#define YCSB_C_SYSINFO_H_
+
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include <unistd.h>
+
+namespace ycsbc {
+
+namespace utils {
+
+struct CacheInfo {
+  std::string name; // "L1d", "L2", "L3", ...
+  uint64_t size; // in bytes
+};
+
+///
+/// Data and unified caches of cpu0, smallest first. Empty if sysfs does not
+/// describe them.
+///
+inline std::vector<CacheInfo> GetCacheSizes() {
+  std::vector<CacheInfo> caches;
+  for (int index = 0; ; index++) {
+    const std::string dir = "/sys/devices/system/cpu/cpu0/cache/index" + std::to_string(index) + "/";
+    std::ifstream level_file(dir + "level");
+    std::ifstream type_file(dir + "type");
+    std::ifstream size_file(dir + "size");
+    int level;
+    std::string type;
+    std::string size;
+    if (!(level_file >> level) || !(type_file >> type) || !(size_file >> size)) {
+      break;
+    }
+    if (type == "Instruction") {
+      continue;
+    }
+    // sizes look like "48K" or "32M"
+    uint64_t bytes = std::stoull(size);
+    switch (size.back()) {
+    case 'K':
+      bytes <<= 10;
+      break;
+    case 'M':
+      bytes <<= 20;
+      break;
+    case 'G':
+      bytes <<= 30;
+      break;
+    }
+    caches.push_back({"L" + std::to_string(level) + (type == "Data" ? "d" : ""), bytes});
+  }
+  return caches;
+}
+
+///
+/// Resident set size of this process in bytes, 0 if unknown.
+///
+inline uint64_t GetResidentBytes() {
+  std::ifstream statm("/proc/self/statm");
+  uint64_t size;
+  uint64_t resident;
+  if (!(statm >> size >> resident)) {
+    return 0;
+  }
+  return resident * sysconf(_SC_PAGESIZE);
+}
+
+} // utils
+
+} // ycsbc
+
+#endif // YCSB_C_SYSINFO_H_
@@ -0,0 +1,60 @@
+//
+//  thread_control.h
+//  YCSB-cpp
+//
+
+#ifndef YCSB_C_THREAD_CONTROL_H_
+#define YCSB_C_THREAD_CONTROL_H_
+
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
+
+namespace ycsbc {
+
+namespace utils {
+
+///
+/// Lets other threads stop a worker thread, or park it until it is resumed.
+/// The worker calls Continue between units of work.
+///
+class ThreadControl {
+ public:
+  ThreadControl() : stopped_(false), parked_(false) {}
+  ///
+  /// Blocks while parked. Returns false once the worker should stop.
+  ///
+  bool Continue() {
+    if (!parked_.load(std::memory_order_relaxed)) {
+      return !stopped_.load(std::memory_order_relaxed);
+    }
+    std::unique_lock<std::mutex> lock(mu_);
+    cv_.wait(lock, [this]{return !parked_ || stopped_;});
+    return !stopped_;
+  }
+  void Park() {
+    std::unique_lock<std::mutex> lock(mu_);
+    parked_ = true;
+  }
+  void Resume() {
+    std::unique_lock<std::mutex> lock(mu_);
+    parked_ = false;
+    cv_.notify_all();
+  }
+  void Stop() {
+    std::unique_lock<std::mutex> lock(mu_);
+    stopped_ = true;
+    cv_.notify_all();
+  }
+ private:
+  std::atomic<bool> stopped_;
+  std::atomic<bool> parked_;
+  std::mutex mu_;
+  std::condition_variable cv_;
+};
+
+} // utils
+
+} // ycsbc
+
+#endif // YCSB_C_THREAD_CONTROL_H_